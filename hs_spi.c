@@ -27,6 +27,7 @@ struct _hs_spi
     int fd;
     hs_spi_cs_control_cb cs_control_cb;
     size_t max_transfer_len;
+    uint32_t speed_hz;
     pthread_mutex_t mutex;
 };
 
@@ -65,6 +66,7 @@ hs_spi_t *hs_spi_create(void)
     hs_spi->fd = -1;
     hs_spi->cs_control_cb = NULL;
     hs_spi->max_transfer_len = 0;
+    hs_spi->speed_hz = 0;
     pthread_mutex_init(&hs_spi->mutex, NULL);
 
     return hs_spi;
@@ -159,6 +161,7 @@ int hs_spi_init(hs_spi_t *hs_spi, const char *spi_name, const hs_spi_mode_e spi_
     }
 
     hs_spi->fd = fd;
+    hs_spi->speed_hz = spi_speed_hz;
     hs_spi->max_transfer_len = hs_spi->max_transfer_len == 0 ? 4096 : hs_spi->max_transfer_len;
     pthread_mutex_unlock(&hs_spi->mutex);
 
@@ -214,6 +217,58 @@ int hs_spi_set_max_transfer_len(hs_spi_t *hs_spi, const size_t max_transfer_len)
     return 0;
 }
 
+int hs_spi_get_max_transfer_len(hs_spi_t *hs_spi, size_t *max_transfer_len)
+{
+    if (hs_spi == NULL)
+    {
+        return -1;
+    }
+
+    if (max_transfer_len == NULL)
+    {
+        return -2;
+    }
+
+    pthread_mutex_lock(&hs_spi->mutex);
+    if (hs_spi->fd == -1)
+    {
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return -3;
+    }
+
+    *max_transfer_len = hs_spi->max_transfer_len;
+    pthread_mutex_unlock(&hs_spi->mutex);
+
+    return 0;
+}
+
+int hs_spi_get_speed_hz(hs_spi_t *hs_spi, uint32_t *speed_hz)
+{
+    if (hs_spi == NULL)
+    {
+        return -1;
+    }
+
+    if (speed_hz == NULL)
+    {
+        return -2;
+    }
+
+    pthread_mutex_lock(&hs_spi->mutex);
+    if (hs_spi->fd == -1)
+    {
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return -3;
+    }
+
+    *speed_hz = hs_spi->speed_hz;
+    pthread_mutex_unlock(&hs_spi->mutex);
+
+    return 0;
+}
+
 int hs_spi_write_data(hs_spi_t *hs_spi, const uint8_t *write_data, const size_t write_data_len)
 {
     if (hs_spi == NULL)
@@ -470,6 +525,220 @@ int hs_spi_write_read_data(hs_spi_t *hs_spi, const uint8_t *write_data, const si
     return 0;
 }
 
+int hs_spi_write_then_read_data(hs_spi_t *hs_spi, const uint8_t *write_data, const size_t write_data_len,
+                                uint8_t *read_data, const size_t read_data_len)
+{
+    if (hs_spi == NULL)
+    {
+        return -1;
+    }
+
+    if (write_data == NULL)
+    {
+        return -2;
+    }
+
+    if (write_data_len == 0)
+    {
+        return -3;
+    }
+
+    if (read_data == NULL)
+    {
+        return -4;
+    }
+
+    if (read_data_len == 0)
+    {
+        return -5;
+    }
+
+    pthread_mutex_lock(&hs_spi->mutex);
+    if (hs_spi->fd < 0)
+    {
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return -6;
+    }
+
+    if (write_data_len > hs_spi->max_transfer_len)
+    {
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return -7;
+    }
+
+    if (hs_spi_cs_control(hs_spi, true) < 0)
+    {
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return -8;
+    }
+
+    struct spi_ioc_transfer spi_transfer[2] = {0};
+    spi_transfer[0].tx_buf = (unsigned long)write_data;
+    spi_transfer[0].len = write_data_len;
+    spi_transfer[0].cs_change = 0;
+
+    // 剩余未读取数据长度
+    size_t remain_data_len = read_data_len;
+    while (remain_data_len > 0)
+    {
+        // 本次读取数据长度
+        size_t current_len = remain_data_len > hs_spi->max_transfer_len ? hs_spi->max_transfer_len : remain_data_len;
+        // 本次读取数据偏移量
+        size_t data_offset = read_data_len - remain_data_len;
+
+        int ret = -1;
+        // 第一包数据需要先发送写入数据
+        if (remain_data_len == read_data_len)
+        {
+            memset(&spi_transfer[1], 0, sizeof(spi_transfer[1]));
+            spi_transfer[1].rx_buf = (unsigned long)&read_data[data_offset];
+            spi_transfer[1].len = current_len;
+            spi_transfer[1].cs_change = 0;
+
+            ret = ioctl(hs_spi->fd, SPI_IOC_MESSAGE(2), &spi_transfer);
+        }
+        // 后续数据不需要发送写入数据
+        else
+        {
+            memset(&spi_transfer[0], 0, sizeof(spi_transfer[0]));
+            spi_transfer[0].rx_buf = (unsigned long)&read_data[data_offset];
+            spi_transfer[0].len = current_len;
+            spi_transfer[0].cs_change = 0;
+
+            ret = ioctl(hs_spi->fd, SPI_IOC_MESSAGE(1), &spi_transfer[0]);
+        }
+
+        if (ret < 0)
+        {
+            hs_spi_cs_control(hs_spi, false);
+            pthread_mutex_unlock(&hs_spi->mutex);
+
+            return -9;
+        }
+
+        remain_data_len -= current_len;
+    }
+
+    hs_spi_cs_control(hs_spi, false);
+
+    if (remain_data_len != 0)
+    {
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return -10;
+    }
+
+    pthread_mutex_unlock(&hs_spi->mutex);
+
+    return 0;
+}
+
+int hs_spi_transfer(hs_spi_t *hs_spi, const hs_spi_xfer_t *xfers, const size_t xfer_count)
+{
+    if (hs_spi == NULL)
+    {
+        return -1;
+    }
+
+    if (xfers == NULL)
+    {
+        return -2;
+    }
+
+    if (xfer_count == 0)
+    {
+        return -3;
+    }
+
+    pthread_mutex_lock(&hs_spi->mutex);
+    if (hs_spi->fd < 0)
+    {
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return -4;
+    }
+
+    size_t total_len = 0;
+    for (size_t i = 0; i < xfer_count; i++)
+    {
+        total_len += xfers[i].len;
+    }
+
+    if ((total_len > hs_spi->max_transfer_len) || (xfer_count > HS_SPI_MAX_XFER_COUNT))
+    {
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return -5;
+    }
+
+    struct spi_ioc_transfer *spi_transfer =
+        (struct spi_ioc_transfer *)calloc(xfer_count, sizeof(struct spi_ioc_transfer));
+    if (spi_transfer == NULL)
+    {
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return -6;
+    }
+
+    for (size_t i = 0; i < xfer_count; i++)
+    {
+        spi_transfer[i].tx_buf = (unsigned long)xfers[i].tx_buf;
+        spi_transfer[i].rx_buf = (unsigned long)xfers[i].rx_buf;
+        spi_transfer[i].len = xfers[i].len;
+        spi_transfer[i].cs_change = (i + 1 < xfer_count) && xfers[i].cs_change;
+    }
+
+    // 未设置片选回调时由内核在帧间切换片选，整条消息一次提交
+    if (hs_spi->cs_control_cb == NULL)
+    {
+        int ret = ioctl(hs_spi->fd, SPI_IOC_MESSAGE(xfer_count), spi_transfer);
+        free(spi_transfer);
+        pthread_mutex_unlock(&hs_spi->mutex);
+
+        return ret < 0 ? -7 : 0;
+    }
+
+    // 设置片选回调时内核无法切换片选脚，按帧分组提交
+    size_t group_start = 0;
+    for (size_t i = 0; i < xfer_count; i++)
+    {
+        if ((i + 1 < xfer_count) && !xfers[i].cs_change)
+        {
+            continue;
+        }
+
+        spi_transfer[i].cs_change = 0;
+        if (hs_spi_cs_control(hs_spi, true) < 0)
+        {
+            free(spi_transfer);
+            pthread_mutex_unlock(&hs_spi->mutex);
+
+            return -8;
+        }
+
+        size_t group_count = i + 1 - group_start;
+        if (ioctl(hs_spi->fd, SPI_IOC_MESSAGE(group_count), &spi_transfer[group_start]) < 0)
+        {
+            hs_spi_cs_control(hs_spi, false);
+            free(spi_transfer);
+            pthread_mutex_unlock(&hs_spi->mutex);
+
+            return -7;
+        }
+
+        hs_spi_cs_control(hs_spi, false);
+        group_start = i + 1;
+    }
+
+    free(spi_transfer);
+    pthread_mutex_unlock(&hs_spi->mutex);
+
+    return 0;
+}
+
 int hs_spi_write_data_sub(hs_spi_t *hs_spi, const uint8_t reg_addr, const uint8_t *write_data,
                           const size_t write_data_len)
 {
@@ -43,6 +43,18 @@ typedef enum hs_spi_mode
     E_HS_SPI_MODE_3 = (HS_SPI_CPOL | HS_SPI_CPHA),
 } hs_spi_mode_e;
 
+// 单条消息最大传输段数（受 SPI_IOC_MESSAGE 参数大小限制）
+#define HS_SPI_MAX_XFER_COUNT 511
+
+// SPI 传输段
+typedef struct hs_spi_xfer
+{
+    const uint8_t *tx_buf; // 待写入的数据（NULL: 发送 0）
+    uint8_t *rx_buf;       // 读取到的数据（NULL: 丢弃）
+    size_t len;            // 传输长度
+    bool cs_change;        // 该段结束后是否释放片选（用于在一条消息内分隔多帧）
+} hs_spi_xfer_t;
+
 // SPI 对象
 typedef struct _hs_spi hs_spi_t;
 
@@ -114,6 +126,28 @@ int hs_spi_set_cs_control_cb(hs_spi_t *hs_spi, hs_spi_cs_control_cb cs_control_c
  */
 int hs_spi_set_max_transfer_len(hs_spi_t *hs_spi, const size_t max_transfer_len);
 
+/**
+ * @brief 获取 SPI 单次最大传输长度
+ *
+ * @param[in,out] hs_spi          : SPI 对象
+ * @param[out]    max_transfer_len: SPI 单次最大传输长度（单位：字节）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_get_max_transfer_len(hs_spi_t *hs_spi, size_t *max_transfer_len);
+
+/**
+ * @brief 获取 SPI 速率
+ *
+ * @param[in,out] hs_spi  : SPI 对象
+ * @param[out]    speed_hz: 初始化时设置的 SPI 速率（单位：Hz）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_get_speed_hz(hs_spi_t *hs_spi, uint32_t *speed_hz);
+
 /**
  * @brief 向无寄存器地址的 SPI 设备写数据
  *
@@ -155,6 +189,41 @@ int hs_spi_read_data(hs_spi_t *hs_spi, uint8_t *read_data, const size_t read_dat
 int hs_spi_write_read_data(hs_spi_t *hs_spi, const uint8_t *write_data, const size_t write_data_len, uint8_t *read_data,
                            const size_t read_data_len);
 
+/**
+ * @brief 无寄存器地址的 SPI 设备先写后读（半双工）
+ *
+ * @note 1. 写入数据与读取数据在同一次片选内完成，适用于"命令 + 地址"后读取数据的外设（如 SPI NOR Flash）
+ *       2. 写入数据长度不能超过 SPI 单次最大传输长度
+ *
+ * @param[in,out] hs_spi        : SPI 对象
+ * @param[in]     write_data    : 待写入的数据
+ * @param[in]     write_data_len: 待写入的数据长度
+ * @param[out]    read_data     : 读取到的数据
+ * @param[in]     read_data_len : 指定读取数据长度
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_write_then_read_data(hs_spi_t *hs_spi, const uint8_t *write_data, const size_t write_data_len,
+                                uint8_t *read_data, const size_t read_data_len);
+
+/**
+ * @brief 以一条消息提交多个传输段
+ *
+ * @note 1. 所有传输段通过一次 ioctl() 提交，段间由 cs_change 决定是否释放片选，适合将多帧合并为一次系统调用
+ *       2. 传输段长度总和不能超过 SPI 单次最大传输长度，传输段数量不能超过 HS_SPI_MAX_XFER_COUNT，内部不分片
+ *       3. 最后一段的 cs_change 被忽略，消息结束后始终释放片选
+ *       4. 设置了片选脚控制回调函数时，按 cs_change 分组，每组单独控制片选并调用一次 ioctl()
+ *
+ * @param[in,out] hs_spi    : SPI 对象
+ * @param[in]     xfers     : 传输段数组
+ * @param[in]     xfer_count: 传输段数量
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_transfer(hs_spi_t *hs_spi, const hs_spi_xfer_t *xfers, const size_t xfer_count);
+
 /**
  * @brief 向有寄存器地址的 SPI 设备写数据
  *
@@ -0,0 +1,697 @@
+/**
+ * @file      hs_spi_bridge.c
+ * @brief     SPI 转 FPGA 寄存器总线桥接模块源文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 14:05:18
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "hs_spi_bridge.h"
+
+// 已缓冲的写帧
+typedef struct hs_spi_bridge_write_frame
+{
+    size_t offset;      // 帧在写缓冲区中的偏移
+    size_t len;         // 帧长度
+    size_t count;       // 数据个数
+    uint32_t next_addr; // 可追加到该帧的下一个地址
+    bool incr;          // 是否地址自增
+} hs_spi_bridge_write_frame_t;
+
+// 待发送的读帧
+typedef struct hs_spi_bridge_read_frame
+{
+    size_t header_offset; // 帧头在帧头缓冲区中的偏移
+    size_t header_len;    // 帧头长度
+    size_t rx_offset;     // 数据在接收缓冲区中的偏移
+    size_t count;         // 数据个数
+    size_t out_start;     // 第一个数据对应的输出序号
+} hs_spi_bridge_read_frame_t;
+
+// 桥接对象
+struct _hs_spi_bridge
+{
+    hs_spi_t *hs_spi;
+    hs_spi_bridge_config_t config;
+    bool inited;
+    size_t frame_cap; // 单条消息最大帧数
+
+    uint8_t *write_buf; // 写帧缓冲区
+    size_t write_len;
+    hs_spi_bridge_write_frame_t *write_frames;
+    size_t write_count;
+
+    uint8_t *header_buf; // 读帧头缓冲区
+    size_t header_len;
+    uint8_t *rx_buf; // 读数据缓冲区
+    size_t rx_len;
+    hs_spi_bridge_read_frame_t *read_frames;
+    size_t read_count;
+
+    hs_spi_xfer_t *xfers;
+    pthread_mutex_t mutex;
+};
+
+// 地址与原始序号，用于读寄存器列表排序
+typedef struct hs_spi_bridge_addr_index
+{
+    uint32_t addr;
+    size_t index;
+} hs_spi_bridge_addr_index_t;
+
+static int hs_spi_bridge_addr_index_cmp(const void *a, const void *b)
+{
+    const hs_spi_bridge_addr_index_t *x = (const hs_spi_bridge_addr_index_t *)a;
+    const hs_spi_bridge_addr_index_t *y = (const hs_spi_bridge_addr_index_t *)b;
+    if (x->addr != y->addr)
+    {
+        return x->addr < y->addr ? -1 : 1;
+    }
+
+    return x->index < y->index ? -1 : (x->index > y->index ? 1 : 0);
+}
+
+/**
+ * @brief 组包帧头
+ *
+ * @param[in]  hs_spi_bridge: 桥接对象
+ * @param[out] buf          : 帧头缓冲区
+ * @param[in]  cmd          : 命令
+ * @param[in]  addr         : 起始地址
+ * @param[in]  dummy_len    : 等待字节数
+ *
+ * @return 帧头长度
+ */
+static size_t hs_spi_bridge_encode_header(const hs_spi_bridge_t *hs_spi_bridge, uint8_t *buf, const uint8_t cmd,
+                                          const uint32_t addr, const uint8_t dummy_len)
+{
+    uint8_t addr_len = hs_spi_bridge->config.addr_len;
+
+    buf[0] = cmd;
+    for (uint8_t i = 0; i < addr_len; i++)
+    {
+        buf[1 + i] = (uint8_t)(addr >> (8 * (addr_len - 1 - i)));
+    }
+    memset(&buf[1 + addr_len], 0, dummy_len);
+
+    return 1 + addr_len + dummy_len;
+}
+
+static void hs_spi_bridge_encode_word(const hs_spi_bridge_t *hs_spi_bridge, uint8_t *buf, const uint32_t value)
+{
+    uint8_t data_len = hs_spi_bridge->config.data_len;
+    for (uint8_t i = 0; i < data_len; i++)
+    {
+        uint8_t shift = hs_spi_bridge->config.data_little_endian ? i : (data_len - 1 - i);
+        buf[i] = (uint8_t)(value >> (8 * shift));
+    }
+}
+
+static uint32_t hs_spi_bridge_decode_word(const hs_spi_bridge_t *hs_spi_bridge, const uint8_t *buf)
+{
+    uint8_t data_len = hs_spi_bridge->config.data_len;
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < data_len; i++)
+    {
+        uint8_t shift = hs_spi_bridge->config.data_little_endian ? i : (data_len - 1 - i);
+        value |= (uint32_t)buf[i] << (8 * shift);
+    }
+
+    return value;
+}
+
+/**
+ * @brief 将已缓冲的写帧和待发送的读帧作为一条消息提交
+ *
+ * @note 无论成功与否，提交后写帧和读帧均被清空，读数据由调用者在清空前解析
+ *
+ * @param[in] hs_spi_bridge: 桥接对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_bridge_submit(hs_spi_bridge_t *hs_spi_bridge)
+{
+    size_t xfer_count = 0;
+    for (size_t i = 0; i < hs_spi_bridge->write_count; i++)
+    {
+        hs_spi_xfer_t *xfer = &hs_spi_bridge->xfers[xfer_count++];
+        xfer->tx_buf = &hs_spi_bridge->write_buf[hs_spi_bridge->write_frames[i].offset];
+        xfer->rx_buf = NULL;
+        xfer->len = hs_spi_bridge->write_frames[i].len;
+        xfer->cs_change = true;
+    }
+
+    for (size_t i = 0; i < hs_spi_bridge->read_count; i++)
+    {
+        hs_spi_bridge_read_frame_t *frame = &hs_spi_bridge->read_frames[i];
+
+        hs_spi_xfer_t *xfer = &hs_spi_bridge->xfers[xfer_count++];
+        xfer->tx_buf = &hs_spi_bridge->header_buf[frame->header_offset];
+        xfer->rx_buf = NULL;
+        xfer->len = frame->header_len;
+        xfer->cs_change = false;
+
+        xfer = &hs_spi_bridge->xfers[xfer_count++];
+        xfer->tx_buf = NULL;
+        xfer->rx_buf = &hs_spi_bridge->rx_buf[frame->rx_offset];
+        xfer->len = frame->count * hs_spi_bridge->config.data_len;
+        xfer->cs_change = true;
+    }
+
+    hs_spi_bridge->write_len = 0;
+    hs_spi_bridge->write_count = 0;
+    if (xfer_count == 0)
+    {
+        return 0;
+    }
+
+    return hs_spi_transfer(hs_spi_bridge->hs_spi, hs_spi_bridge->xfers, xfer_count) < 0 ? -1 : 0;
+}
+
+/**
+ * @brief 提交消息并解析读数据
+ *
+ * @param[in]  hs_spi_bridge: 桥接对象
+ * @param[out] values       : 读取到的值
+ * @param[in]  index        : 输出序号到 values 下标的映射（NULL: 一一对应）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_bridge_submit_reads(hs_spi_bridge_t *hs_spi_bridge, uint32_t *values, const size_t *index)
+{
+    int ret = hs_spi_bridge_submit(hs_spi_bridge);
+    if (ret == 0)
+    {
+        for (size_t i = 0; i < hs_spi_bridge->read_count; i++)
+        {
+            hs_spi_bridge_read_frame_t *frame = &hs_spi_bridge->read_frames[i];
+            for (size_t j = 0; j < frame->count; j++)
+            {
+                size_t out = frame->out_start + j;
+                const uint8_t *data = &hs_spi_bridge->rx_buf[frame->rx_offset + j * hs_spi_bridge->config.data_len];
+                values[index == NULL ? out : index[out]] = hs_spi_bridge_decode_word(hs_spi_bridge, data);
+            }
+        }
+    }
+
+    hs_spi_bridge->header_len = 0;
+    hs_spi_bridge->rx_len = 0;
+    hs_spi_bridge->read_count = 0;
+
+    return ret;
+}
+
+/**
+ * @brief 写操作入队
+ *
+ * @note 1. 与最后一个写帧地址连续且方式相同时追加到该帧，否则新建帧；缓冲区满时先发送已缓冲的写帧
+ *       2. 设备不支持固定地址突发（incr_flag 为 0）时，固定地址写每帧只包含一个数据，不与其他写合并
+ *
+ * @param[in] hs_spi_bridge: 桥接对象
+ * @param[in] addr         : 起始地址
+ * @param[in] values       : 写入值
+ * @param[in] count        : 写入个数
+ * @param[in] incr         : 是否地址自增
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_bridge_post(hs_spi_bridge_t *hs_spi_bridge, uint32_t addr, const uint32_t *values, size_t count,
+                              const bool incr)
+{
+    const hs_spi_bridge_config_t *config = &hs_spi_bridge->config;
+    size_t header_len = 1 + config->addr_len;
+
+    while (count > 0)
+    {
+        size_t room = config->max_message_len - hs_spi_bridge->write_len;
+        hs_spi_bridge_write_frame_t *last = NULL;
+        if (hs_spi_bridge->write_count > 0)
+        {
+            last = &hs_spi_bridge->write_frames[hs_spi_bridge->write_count - 1];
+        }
+
+        // 追加到最后一个写帧
+        size_t frame_max = (!incr && (config->incr_flag == 0)) ? 1 : config->max_burst;
+        if ((last != NULL) && (last->incr == incr) && (last->next_addr == addr) && (room >= config->data_len) &&
+            ((frame_max == 0) || (last->count < frame_max)))
+        {
+            size_t n = room / config->data_len;
+            n = n < count ? n : count;
+            if ((frame_max > 0) && (n > frame_max - last->count))
+            {
+                n = frame_max - last->count;
+            }
+
+            for (size_t i = 0; i < n; i++)
+            {
+                hs_spi_bridge_encode_word(hs_spi_bridge, &hs_spi_bridge->write_buf[hs_spi_bridge->write_len], values[i]);
+                hs_spi_bridge->write_len += config->data_len;
+            }
+
+            last->len += n * config->data_len;
+            last->count += n;
+            if (incr)
+            {
+                addr += (uint32_t)n * config->addr_step;
+                last->next_addr = addr;
+            }
+            values += n;
+            count -= n;
+
+            continue;
+        }
+
+        // 缓冲区放不下新帧时先发送
+        if ((hs_spi_bridge->write_count >= hs_spi_bridge->frame_cap) || (room < header_len + config->data_len))
+        {
+            if (hs_spi_bridge_submit(hs_spi_bridge) < 0)
+            {
+                return -1;
+            }
+
+            continue;
+        }
+
+        hs_spi_bridge_write_frame_t *frame = &hs_spi_bridge->write_frames[hs_spi_bridge->write_count++];
+        frame->offset = hs_spi_bridge->write_len;
+        frame->len = hs_spi_bridge_encode_header(hs_spi_bridge, &hs_spi_bridge->write_buf[hs_spi_bridge->write_len],
+                                                 config->write_cmd | (incr ? config->incr_flag : 0), addr, 0);
+        frame->count = 0;
+        frame->next_addr = addr;
+        frame->incr = incr;
+        hs_spi_bridge->write_len += frame->len;
+    }
+
+    if (!config->posted_write)
+    {
+        return hs_spi_bridge_submit(hs_spi_bridge) < 0 ? -1 : 0;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 读操作入队
+ *
+ * @note 读帧排在已缓冲的写帧之后，消息放不下时先提交并解析
+ *
+ * @param[in]  hs_spi_bridge: 桥接对象
+ * @param[in]  addr         : 起始地址
+ * @param[in]  count        : 读取个数
+ * @param[in]  incr         : 是否地址自增
+ * @param[out] values       : 读取到的值
+ * @param[in]  index        : 输出序号到 values 下标的映射（NULL: 一一对应）
+ * @param[in]  out_start    : 第一个数据对应的输出序号
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_bridge_queue_read(hs_spi_bridge_t *hs_spi_bridge, uint32_t addr, size_t count, const bool incr,
+                                    uint32_t *values, const size_t *index, size_t out_start)
+{
+    const hs_spi_bridge_config_t *config = &hs_spi_bridge->config;
+    size_t header_len = 1 + config->addr_len + config->dummy_len;
+
+    while (count > 0)
+    {
+        size_t used = hs_spi_bridge->write_len + hs_spi_bridge->header_len + hs_spi_bridge->rx_len;
+        size_t room = config->max_message_len - used;
+        if ((hs_spi_bridge->write_count + hs_spi_bridge->read_count >= hs_spi_bridge->frame_cap) ||
+            (room < header_len + config->data_len))
+        {
+            if (hs_spi_bridge_submit_reads(hs_spi_bridge, values, index) < 0)
+            {
+                return -1;
+            }
+
+            continue;
+        }
+
+        size_t n = (room - header_len) / config->data_len;
+        n = n < count ? n : count;
+        if ((config->max_burst > 0) && (n > config->max_burst))
+        {
+            n = config->max_burst;
+        }
+
+        hs_spi_bridge_read_frame_t *frame = &hs_spi_bridge->read_frames[hs_spi_bridge->read_count++];
+        frame->header_offset = hs_spi_bridge->header_len;
+        frame->header_len =
+            hs_spi_bridge_encode_header(hs_spi_bridge, &hs_spi_bridge->header_buf[hs_spi_bridge->header_len],
+                                        config->read_cmd | (incr ? config->incr_flag : 0), addr, config->dummy_len);
+        frame->rx_offset = hs_spi_bridge->rx_len;
+        frame->count = n;
+        frame->out_start = out_start;
+        hs_spi_bridge->header_len += frame->header_len;
+        hs_spi_bridge->rx_len += n * config->data_len;
+
+        if (incr)
+        {
+            addr += (uint32_t)n * config->addr_step;
+        }
+        count -= n;
+        out_start += n;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 释放初始化时申请的资源
+ *
+ * @param[in] hs_spi_bridge: 桥接对象
+ */
+static void hs_spi_bridge_release(hs_spi_bridge_t *hs_spi_bridge)
+{
+    free(hs_spi_bridge->write_buf);
+    free(hs_spi_bridge->write_frames);
+    free(hs_spi_bridge->header_buf);
+    free(hs_spi_bridge->rx_buf);
+    free(hs_spi_bridge->read_frames);
+    free(hs_spi_bridge->xfers);
+    hs_spi_bridge->write_buf = NULL;
+    hs_spi_bridge->write_frames = NULL;
+    hs_spi_bridge->header_buf = NULL;
+    hs_spi_bridge->rx_buf = NULL;
+    hs_spi_bridge->read_frames = NULL;
+    hs_spi_bridge->xfers = NULL;
+    hs_spi_bridge->write_len = 0;
+    hs_spi_bridge->write_count = 0;
+    hs_spi_bridge->header_len = 0;
+    hs_spi_bridge->rx_len = 0;
+    hs_spi_bridge->read_count = 0;
+    hs_spi_bridge->inited = false;
+}
+
+hs_spi_bridge_t *hs_spi_bridge_create(void)
+{
+    hs_spi_bridge_t *hs_spi_bridge = (hs_spi_bridge_t *)malloc(sizeof(hs_spi_bridge_t));
+    if (hs_spi_bridge == NULL)
+    {
+        return NULL;
+    }
+
+    memset(hs_spi_bridge, 0, sizeof(hs_spi_bridge_t));
+    pthread_mutex_init(&hs_spi_bridge->mutex, NULL);
+
+    return hs_spi_bridge;
+}
+
+int hs_spi_bridge_init(hs_spi_bridge_t *hs_spi_bridge, hs_spi_t *hs_spi, const hs_spi_bridge_config_t *config)
+{
+    if (hs_spi_bridge == NULL)
+    {
+        return -1;
+    }
+
+    if (hs_spi == NULL)
+    {
+        return -2;
+    }
+
+    if (config == NULL)
+    {
+        return -3;
+    }
+
+    size_t max_transfer_len = 0;
+    if (hs_spi_get_max_transfer_len(hs_spi, &max_transfer_len) < 0)
+    {
+        return -2;
+    }
+
+    // 一条消息在一次传输中发送，不能超过 SPI 单次最大传输长度
+    hs_spi_bridge_config_t cfg = *config;
+    cfg.addr_step = cfg.addr_step == 0 ? cfg.data_len : cfg.addr_step;
+    if (cfg.max_message_len == 0)
+    {
+        cfg.max_message_len = max_transfer_len < 4096 ? max_transfer_len : 4096;
+    }
+    if ((cfg.addr_len == 0) || (cfg.addr_len > 4) ||
+        ((cfg.data_len != 1) && (cfg.data_len != 2) && (cfg.data_len != 4)) ||
+        (cfg.max_message_len < (size_t)1 + cfg.addr_len + cfg.dummy_len + cfg.data_len) ||
+        (cfg.max_message_len > max_transfer_len))
+    {
+        return -4;
+    }
+
+    pthread_mutex_lock(&hs_spi_bridge->mutex);
+    if (hs_spi_bridge->inited)
+    {
+        hs_spi_bridge_submit(hs_spi_bridge);
+    }
+    hs_spi_bridge_release(hs_spi_bridge);
+
+    hs_spi_bridge->hs_spi = hs_spi;
+    hs_spi_bridge->config = cfg;
+    // 最短的帧为单个数据的写帧，读帧占用 2 个传输段
+    hs_spi_bridge->frame_cap = cfg.max_message_len / (1 + cfg.addr_len + cfg.data_len) + 1;
+    if (hs_spi_bridge->frame_cap > HS_SPI_MAX_XFER_COUNT / 2)
+    {
+        hs_spi_bridge->frame_cap = HS_SPI_MAX_XFER_COUNT / 2;
+    }
+    hs_spi_bridge->write_buf = (uint8_t *)malloc(cfg.max_message_len);
+    hs_spi_bridge->write_frames =
+        (hs_spi_bridge_write_frame_t *)calloc(hs_spi_bridge->frame_cap, sizeof(hs_spi_bridge_write_frame_t));
+    hs_spi_bridge->header_buf = (uint8_t *)malloc(cfg.max_message_len);
+    hs_spi_bridge->rx_buf = (uint8_t *)malloc(cfg.max_message_len);
+    hs_spi_bridge->read_frames =
+        (hs_spi_bridge_read_frame_t *)calloc(hs_spi_bridge->frame_cap, sizeof(hs_spi_bridge_read_frame_t));
+    hs_spi_bridge->xfers = (hs_spi_xfer_t *)calloc(hs_spi_bridge->frame_cap * 2, sizeof(hs_spi_xfer_t));
+    if ((hs_spi_bridge->write_buf == NULL) || (hs_spi_bridge->write_frames == NULL) ||
+        (hs_spi_bridge->header_buf == NULL) || (hs_spi_bridge->rx_buf == NULL) ||
+        (hs_spi_bridge->read_frames == NULL) || (hs_spi_bridge->xfers == NULL))
+    {
+        hs_spi_bridge_release(hs_spi_bridge);
+        pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+        return -5;
+    }
+
+    hs_spi_bridge->inited = true;
+    pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+    return 0;
+}
+
+int hs_spi_bridge_destroy(hs_spi_bridge_t *hs_spi_bridge)
+{
+    if (hs_spi_bridge == NULL)
+    {
+        return -1;
+    }
+
+    int ret = 0;
+    pthread_mutex_lock(&hs_spi_bridge->mutex);
+    if (hs_spi_bridge->inited && (hs_spi_bridge_submit(hs_spi_bridge) < 0))
+    {
+        ret = -2;
+    }
+    hs_spi_bridge_release(hs_spi_bridge);
+    pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+    pthread_mutex_destroy(&hs_spi_bridge->mutex);
+    free(hs_spi_bridge);
+
+    return ret;
+}
+
+int hs_spi_bridge_write(hs_spi_bridge_t *hs_spi_bridge, const uint32_t addr, const uint32_t value)
+{
+    return hs_spi_bridge_write_burst(hs_spi_bridge, addr, &value, 1, true);
+}
+
+int hs_spi_bridge_write_burst(hs_spi_bridge_t *hs_spi_bridge, const uint32_t addr, const uint32_t *values,
+                              const size_t count, const bool incr)
+{
+    if (hs_spi_bridge == NULL)
+    {
+        return -1;
+    }
+
+    if (values == NULL)
+    {
+        return -2;
+    }
+
+    if (count == 0)
+    {
+        return -3;
+    }
+
+    pthread_mutex_lock(&hs_spi_bridge->mutex);
+    if (!hs_spi_bridge->inited)
+    {
+        pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+        return -4;
+    }
+
+    if (!incr && (count > 1) && (hs_spi_bridge->config.incr_flag == 0))
+    {
+        pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+        return -5;
+    }
+
+    int ret = hs_spi_bridge_post(hs_spi_bridge, addr, values, count, incr);
+    pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+    return ret < 0 ? -6 : 0;
+}
+
+int hs_spi_bridge_read(hs_spi_bridge_t *hs_spi_bridge, const uint32_t addr, uint32_t *value)
+{
+    return hs_spi_bridge_read_burst(hs_spi_bridge, addr, value, 1, true);
+}
+
+int hs_spi_bridge_read_burst(hs_spi_bridge_t *hs_spi_bridge, const uint32_t addr, uint32_t *values,
+                             const size_t count, const bool incr)
+{
+    if (hs_spi_bridge == NULL)
+    {
+        return -1;
+    }
+
+    if (values == NULL)
+    {
+        return -2;
+    }
+
+    if (count == 0)
+    {
+        return -3;
+    }
+
+    pthread_mutex_lock(&hs_spi_bridge->mutex);
+    if (!hs_spi_bridge->inited)
+    {
+        pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+        return -4;
+    }
+
+    if (!incr && (count > 1) && (hs_spi_bridge->config.incr_flag == 0))
+    {
+        pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+        return -5;
+    }
+
+    if ((hs_spi_bridge_queue_read(hs_spi_bridge, addr, count, incr, values, NULL, 0) < 0) ||
+        (hs_spi_bridge_submit_reads(hs_spi_bridge, values, NULL) < 0))
+    {
+        pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+        return -6;
+    }
+    pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+    return 0;
+}
+
+int hs_spi_bridge_read_list(hs_spi_bridge_t *hs_spi_bridge, const uint32_t *addrs, uint32_t *values,
+                            const size_t count)
+{
+    if (hs_spi_bridge == NULL)
+    {
+        return -1;
+    }
+
+    if ((addrs == NULL) || (values == NULL))
+    {
+        return -2;
+    }
+
+    if (count == 0)
+    {
+        return -3;
+    }
+
+    hs_spi_bridge_addr_index_t *sorted =
+        (hs_spi_bridge_addr_index_t *)malloc(count * sizeof(hs_spi_bridge_addr_index_t));
+    size_t *index = (size_t *)malloc(count * sizeof(size_t));
+    if ((sorted == NULL) || (index == NULL))
+    {
+        free(sorted);
+        free(index);
+
+        return -4;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        sorted[i].addr = addrs[i];
+        sorted[i].index = i;
+    }
+    qsort(sorted, count, sizeof(hs_spi_bridge_addr_index_t), hs_spi_bridge_addr_index_cmp);
+    for (size_t i = 0; i < count; i++)
+    {
+        index[i] = sorted[i].index;
+    }
+
+    pthread_mutex_lock(&hs_spi_bridge->mutex);
+    if (!hs_spi_bridge->inited)
+    {
+        pthread_mutex_unlock(&hs_spi_bridge->mutex);
+        free(sorted);
+        free(index);
+
+        return -5;
+    }
+
+    // 相邻地址合并为一个自增读帧
+    int ret = 0;
+    size_t run_start = 0;
+    for (size_t i = 1; (ret == 0) && (i <= count); i++)
+    {
+        if ((i < count) && (sorted[i].addr == sorted[i - 1].addr + hs_spi_bridge->config.addr_step))
+        {
+            continue;
+        }
+
+        ret = hs_spi_bridge_queue_read(hs_spi_bridge, sorted[run_start].addr, i - run_start, true, values, index,
+                                       run_start);
+        run_start = i;
+    }
+
+    if (ret == 0)
+    {
+        ret = hs_spi_bridge_submit_reads(hs_spi_bridge, values, index);
+    }
+    pthread_mutex_unlock(&hs_spi_bridge->mutex);
+    free(sorted);
+    free(index);
+
+    return ret < 0 ? -6 : 0;
+}
+
+int hs_spi_bridge_flush(hs_spi_bridge_t *hs_spi_bridge)
+{
+    if (hs_spi_bridge == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&hs_spi_bridge->mutex);
+    if (!hs_spi_bridge->inited)
+    {
+        pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+        return -2;
+    }
+
+    int ret = hs_spi_bridge_submit(hs_spi_bridge);
+    pthread_mutex_unlock(&hs_spi_bridge->mutex);
+
+    return ret < 0 ? -3 : 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file      hs_spi_bridge.h
+ * @brief     SPI 转 FPGA 寄存器总线桥接模块头文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 14:05:12
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#ifndef __HS_SPI_BRIDGE_H
+#define __HS_SPI_BRIDGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hs_spi.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 帧格式: [命令 1 字节][地址 addr_len 字节，大端][读等待 dummy_len 字节][数据 N * data_len 字节]
+typedef struct hs_spi_bridge_config
+{
+    uint8_t read_cmd;        // 读命令
+    uint8_t write_cmd;       // 写命令
+    uint8_t incr_flag;       // 地址自增标志，自增访问时与命令按位或（为 0 表示设备始终自增，不支持固定地址突发）
+    uint8_t addr_len;        // 地址字节数（1~4）
+    uint8_t dummy_len;       // 读命令在地址后的等待字节数
+    uint8_t data_len;        // 寄存器数据宽度（1/2/4 字节）
+    bool data_little_endian; // 数据是否按小端发送（默认大端）
+    uint32_t addr_step;      // 相邻寄存器地址步进，为 0 使用 data_len（字节寻址）
+    size_t max_burst;        // 单帧最大数据个数，为 0 不限制
+    size_t max_message_len;  // 单条消息最大长度（不能超过 SPI 单次最大传输长度），为 0 使用 4096 与该长度中的较小值
+    bool posted_write;       // 是否启用写缓冲（写操作先入队，读或刷新时合并为一条消息发送）
+} hs_spi_bridge_config_t;
+
+// 桥接对象
+typedef struct _hs_spi_bridge hs_spi_bridge_t;
+
+/**
+ * @brief 创建桥接对象
+ *
+ * @return 成功: 桥接对象
+ * @return 失败: NULL
+ */
+hs_spi_bridge_t *hs_spi_bridge_create(void);
+
+/**
+ * @brief 初始化桥接对象
+ *
+ * @note 1. 该函数支持重复调用，重复调用时会先发送已缓冲的写操作
+ *       2. hs_spi 需已初始化，且在桥接对象销毁前不能销毁
+ *       3. max_message_len 超过 SPI 单次最大传输长度（参考 hs_spi_set_max_transfer_len）时初始化失败
+ *
+ * @param[in,out] hs_spi_bridge: 桥接对象
+ * @param[in]     hs_spi       : SPI 对象
+ * @param[in]     config       : 帧格式配置
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_bridge_init(hs_spi_bridge_t *hs_spi_bridge, hs_spi_t *hs_spi, const hs_spi_bridge_config_t *config);
+
+/**
+ * @brief 销毁桥接对象
+ *
+ * @note 1. 销毁前会发送已缓冲的写操作
+ *       2. 调用该函数前必须确保没有其他线程正在使用该桥接对象，否则可能导致未定义行为
+ *
+ * @param[in,out] hs_spi_bridge: 桥接对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败（缓冲的写操作发送失败，对象仍被销毁）
+ */
+int hs_spi_bridge_destroy(hs_spi_bridge_t *hs_spi_bridge);
+
+/**
+ * @brief 写寄存器
+ *
+ * @note 启用写缓冲时只入队，地址连续的写操作合并为一个自增突发帧
+ *
+ * @param[in,out] hs_spi_bridge: 桥接对象
+ * @param[in]     addr         : 寄存器地址
+ * @param[in]     value        : 写入值
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_bridge_write(hs_spi_bridge_t *hs_spi_bridge, const uint32_t addr, const uint32_t value);
+
+/**
+ * @brief 突发写寄存器
+ *
+ * @param[in,out] hs_spi_bridge: 桥接对象
+ * @param[in]     addr         : 起始寄存器地址
+ * @param[in]     values       : 写入值
+ * @param[in]     count        : 写入个数
+ * @param[in]     incr         : 是否地址自增（false: 全部写入同一地址，如 FIFO）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_bridge_write_burst(hs_spi_bridge_t *hs_spi_bridge, const uint32_t addr, const uint32_t *values,
+                              const size_t count, const bool incr);
+
+/**
+ * @brief 读寄存器
+ *
+ * @note 已缓冲的写操作与本次读操作在同一条消息中先行发送
+ *
+ * @param[in,out] hs_spi_bridge: 桥接对象
+ * @param[in]     addr         : 寄存器地址
+ * @param[out]    value        : 读取到的值
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_bridge_read(hs_spi_bridge_t *hs_spi_bridge, const uint32_t addr, uint32_t *value);
+
+/**
+ * @brief 突发读寄存器
+ *
+ * @param[in,out] hs_spi_bridge: 桥接对象
+ * @param[in]     addr         : 起始寄存器地址
+ * @param[out]    values       : 读取到的值
+ * @param[in]     count        : 读取个数
+ * @param[in]     incr         : 是否地址自增（false: 全部读取同一地址，如 FIFO）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_bridge_read_burst(hs_spi_bridge_t *hs_spi_bridge, const uint32_t addr, uint32_t *values,
+                             const size_t count, const bool incr);
+
+/**
+ * @brief 读寄存器列表
+ *
+ * @note 1. 按地址排序后将相邻地址合并为自增突发帧，所有帧合并为尽量少的消息发送
+ *       2. 读取顺序可能与列表顺序不同，读清零或 FIFO 类寄存器请使用单独读取
+ *
+ * @param[in,out] hs_spi_bridge: 桥接对象
+ * @param[in]     addrs        : 寄存器地址列表
+ * @param[out]    values       : 读取到的值（与地址列表一一对应）
+ * @param[in]     count        : 寄存器个数
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_bridge_read_list(hs_spi_bridge_t *hs_spi_bridge, const uint32_t *addrs, uint32_t *values,
+                            const size_t count);
+
+/**
+ * @brief 发送已缓冲的写操作
+ *
+ * @param[in,out] hs_spi_bridge: 桥接对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败（缓冲的写操作被丢弃）
+ */
+int hs_spi_bridge_flush(hs_spi_bridge_t *hs_spi_bridge);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HS_SPI_BRIDGE_H
@@ -0,0 +1,1011 @@
+/**
+ * @file      hs_spi_executor.c
+ * @brief     SPI 共享工作线程池模块源文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 16:21:09
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "hs_spi_executor.h"
+
+// 排队统计
+typedef struct hs_spi_executor_queue
+{
+    size_t requests;
+    size_t bytes;
+    uint64_t bus_ns; // 估算的总线占用时间（单位：纳秒）
+} hs_spi_executor_queue_t;
+
+// 任务节点
+typedef struct hs_spi_executor_node
+{
+    hs_spi_executor_job_t job;
+    hs_spi_executor_dev_t *dev;
+    uint64_t bus_ns;
+    uint64_t seq; // 提交序号，用于跨控制器查找客户端最早的任务
+    struct hs_spi_executor_node *next;
+} hs_spi_executor_node_t;
+
+// 控制器，线程池调度的基本单位
+typedef struct hs_spi_executor_ctrl
+{
+    uint32_t id;
+    hs_spi_executor_node_t *head; // 待执行任务队列（同一控制器上所有设备按提交顺序排队）
+    hs_spi_executor_node_t *tail;
+    bool scheduled;    // 已在就绪队列中或正在执行
+    size_t home;       // 所属工作线程
+    size_t dev_count;  // 设备数量
+    hs_spi_executor_queue_t queued;
+    struct hs_spi_executor_ctrl *next_ready;
+    struct hs_spi_executor_ctrl *next;
+} hs_spi_executor_ctrl_t;
+
+// 工作线程
+typedef struct hs_spi_executor_worker
+{
+    hs_spi_executor_t *executor;
+    size_t index;
+    pthread_t thread;
+    hs_spi_executor_ctrl_t *ready_head; // 就绪控制器队列
+    hs_spi_executor_ctrl_t *ready_tail;
+} hs_spi_executor_worker_t;
+
+// 线程池中的设备
+struct _hs_spi_executor_dev
+{
+    hs_spi_executor_t *executor;
+    hs_spi_t *hs_spi;
+    hs_spi_executor_ctrl_t *ctrl;
+    uint32_t speed_hz; // 用于估算积压时间
+    hs_spi_executor_limit_t limit;
+    hs_spi_executor_queue_t queued;
+    size_t pending; // 已提交未完成的任务数
+    size_t waiters; // 阻塞在提交中的线程数
+    bool removing;
+    struct _hs_spi_executor_dev *next;
+};
+
+// 线程池客户端
+struct _hs_spi_executor_client
+{
+    hs_spi_executor_t *executor;
+    hs_spi_executor_limit_t limit;
+    hs_spi_executor_queue_t queued;
+    size_t pending;
+    size_t waiters;
+    bool removing;
+    struct _hs_spi_executor_client *next;
+};
+
+// 线程池对象
+struct _hs_spi_executor
+{
+    hs_spi_executor_worker_t *workers;
+    size_t worker_count;
+    size_t next_home; // 新控制器分配的工作线程
+
+    hs_spi_executor_ctrl_t *ctrls;
+    hs_spi_executor_dev_t *devs;
+    hs_spi_executor_client_t *clients;
+    hs_spi_executor_node_t *free_nodes; // 空闲任务节点，复用以避免频繁申请内存
+    uint64_t next_seq;
+    size_t space_waiters; // 等待队列空间的提交线程数
+
+    bool inited;
+    bool stopping;
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;  // 有就绪控制器
+    pthread_cond_t idle_cond;  // 有任务完成
+    pthread_cond_t space_cond; // 有任务出队
+};
+
+static void hs_spi_executor_push_ready(hs_spi_executor_worker_t *worker, hs_spi_executor_ctrl_t *ctrl)
+{
+    ctrl->next_ready = NULL;
+    if (worker->ready_tail == NULL)
+    {
+        worker->ready_head = ctrl;
+    }
+    else
+    {
+        worker->ready_tail->next_ready = ctrl;
+    }
+    worker->ready_tail = ctrl;
+}
+
+static hs_spi_executor_ctrl_t *hs_spi_executor_pop_ready(hs_spi_executor_worker_t *worker)
+{
+    hs_spi_executor_ctrl_t *ctrl = worker->ready_head;
+    if (ctrl != NULL)
+    {
+        worker->ready_head = ctrl->next_ready;
+        if (worker->ready_head == NULL)
+        {
+            worker->ready_tail = NULL;
+        }
+        ctrl->next_ready = NULL;
+    }
+
+    return ctrl;
+}
+
+static void hs_spi_executor_queue_add(hs_spi_executor_queue_t *queue, const hs_spi_executor_node_t *node)
+{
+    queue->requests++;
+    queue->bytes += node->job.bus_bytes;
+    queue->bus_ns += node->bus_ns;
+}
+
+static void hs_spi_executor_queue_sub(hs_spi_executor_queue_t *queue, const hs_spi_executor_node_t *node)
+{
+    queue->requests--;
+    queue->bytes -= node->job.bus_bytes;
+    queue->bus_ns -= node->bus_ns;
+}
+
+/**
+ * @brief 从控制器队列中取出任务
+ *
+ * @note 调用前需持有互斥锁，任务出队后唤醒等待队列空间的提交线程
+ *
+ * @param[in] hs_spi_executor: 线程池对象
+ * @param[in] ctrl           : 控制器
+ * @param[in] prev           : 任务的前一个节点（NULL: 任务为队首）
+ *
+ * @return 取出的任务
+ */
+static hs_spi_executor_node_t *hs_spi_executor_dequeue(hs_spi_executor_t *hs_spi_executor, hs_spi_executor_ctrl_t *ctrl,
+                                                       hs_spi_executor_node_t *prev)
+{
+    hs_spi_executor_node_t *node = prev == NULL ? ctrl->head : prev->next;
+    if (prev == NULL)
+    {
+        ctrl->head = node->next;
+    }
+    else
+    {
+        prev->next = node->next;
+    }
+    if (ctrl->tail == node)
+    {
+        ctrl->tail = prev;
+    }
+    node->next = NULL;
+
+    hs_spi_executor_queue_sub(&ctrl->queued, node);
+    hs_spi_executor_queue_sub(&node->dev->queued, node);
+    if (node->job.client != NULL)
+    {
+        hs_spi_executor_queue_sub(&node->job.client->queued, node);
+    }
+
+    if (hs_spi_executor->space_waiters > 0)
+    {
+        pthread_cond_broadcast(&hs_spi_executor->space_cond);
+    }
+
+    return node;
+}
+
+/**
+ * @brief 任务完成（或被丢弃）后释放任务节点
+ *
+ * @note 调用前需持有互斥锁
+ *
+ * @param[in] hs_spi_executor: 线程池对象
+ * @param[in] node           : 任务节点
+ */
+static void hs_spi_executor_finish(hs_spi_executor_t *hs_spi_executor, hs_spi_executor_node_t *node)
+{
+    hs_spi_executor_dev_t *dev = node->dev;
+    hs_spi_executor_client_t *client = node->job.client;
+
+    dev->pending--;
+    if (client != NULL)
+    {
+        client->pending--;
+    }
+    if ((dev->pending == 0) || ((client != NULL) && (client->pending == 0)))
+    {
+        pthread_cond_broadcast(&hs_spi_executor->idle_cond);
+    }
+
+    node->next = hs_spi_executor->free_nodes;
+    hs_spi_executor->free_nodes = node;
+}
+
+/**
+ * @brief 判断提交任务后是否超出队列深度限制
+ *
+ * @param[in] limit    : 队列深度限制
+ * @param[in] queue    : 当前排队统计
+ * @param[in] bus_bytes: 待提交任务的总线字节数
+ *
+ * @return true : 超出限制
+ * @return false: 未超出限制
+ */
+static bool hs_spi_executor_limit_exceeded(const hs_spi_executor_limit_t *limit, const hs_spi_executor_queue_t *queue,
+                                           const size_t bus_bytes)
+{
+    if ((limit->max_requests > 0) && (queue->requests >= limit->max_requests))
+    {
+        return true;
+    }
+
+    // 队列为空时总是接受，避免单个超过字节限制的任务永远无法提交
+    return (limit->max_bytes > 0) && (queue->requests > 0) && (queue->bytes + bus_bytes > limit->max_bytes);
+}
+
+/**
+ * @brief 丢弃设备或客户端最早提交且未开始执行的任务
+ *
+ * @note 1. 调用前需持有互斥锁，返回时仍持有互斥锁，被丢弃任务的完成回调函数在释放互斥锁后调用
+ *       2. dev 不为 NULL 时只在该设备所在控制器中查找，否则在所有控制器中查找该客户端序号最小的任务
+ *
+ * @param[in] hs_spi_executor: 线程池对象
+ * @param[in] dev            : 设备（NULL: 按客户端查找）
+ * @param[in] client         : 客户端
+ *
+ * @return true : 已丢弃
+ * @return false: 没有可丢弃的任务
+ */
+static bool hs_spi_executor_drop_oldest(hs_spi_executor_t *hs_spi_executor, hs_spi_executor_dev_t *dev,
+                                        hs_spi_executor_client_t *client)
+{
+    hs_spi_executor_ctrl_t *oldest_ctrl = NULL;
+    hs_spi_executor_node_t *oldest_prev = NULL;
+    hs_spi_executor_node_t *oldest = NULL;
+    for (hs_spi_executor_ctrl_t *ctrl = dev != NULL ? dev->ctrl : hs_spi_executor->ctrls; ctrl != NULL;
+         ctrl = dev != NULL ? NULL : ctrl->next)
+    {
+        // 控制器队列按提交顺序排列，每个控制器中第一个匹配的任务即为该控制器上最早的任务
+        hs_spi_executor_node_t *prev = NULL;
+        hs_spi_executor_node_t *node = ctrl->head;
+        while ((node != NULL) && ((dev != NULL) ? (node->dev != dev) : (node->job.client != client)))
+        {
+            prev = node;
+            node = node->next;
+        }
+
+        if ((node != NULL) && ((oldest == NULL) || (node->seq < oldest->seq)))
+        {
+            oldest_ctrl = ctrl;
+            oldest_prev = prev;
+            oldest = node;
+        }
+    }
+
+    if (oldest == NULL)
+    {
+        return false;
+    }
+
+    hs_spi_executor_node_t *node = hs_spi_executor_dequeue(hs_spi_executor, oldest_ctrl, oldest_prev);
+    hs_spi_executor_job_t job = node->job;
+    if (job.done_cb != NULL)
+    {
+        pthread_mutex_unlock(&hs_spi_executor->mutex);
+        job.done_cb(HS_SPI_EXECUTOR_RESULT_DROPPED, job.arg);
+        pthread_mutex_lock(&hs_spi_executor->mutex);
+    }
+    hs_spi_executor_finish(hs_spi_executor, node);
+
+    return true;
+}
+
+/**
+ * @brief 获取下一个就绪控制器
+ *
+ * @note 优先取自身就绪队列，为空时依次从其他工作线程窃取，被窃取的控制器归属到当前工作线程
+ *
+ * @param[in] worker: 工作线程
+ *
+ * @return 成功: 就绪控制器
+ * @return 失败: NULL
+ */
+static hs_spi_executor_ctrl_t *hs_spi_executor_next_ready(hs_spi_executor_worker_t *worker)
+{
+    hs_spi_executor_t *hs_spi_executor = worker->executor;
+
+    hs_spi_executor_ctrl_t *ctrl = hs_spi_executor_pop_ready(worker);
+    for (size_t i = 1; (ctrl == NULL) && (i < hs_spi_executor->worker_count); i++)
+    {
+        size_t victim = (worker->index + i) % hs_spi_executor->worker_count;
+        ctrl = hs_spi_executor_pop_ready(&hs_spi_executor->workers[victim]);
+        if (ctrl != NULL)
+        {
+            ctrl->home = worker->index;
+        }
+    }
+
+    return ctrl;
+}
+
+/**
+ * @brief 工作线程
+ *
+ * @param[in] arg: 工作线程对象
+ *
+ * @return NULL
+ */
+static void *hs_spi_executor_worker_thread(void *arg)
+{
+    hs_spi_executor_worker_t *worker = (hs_spi_executor_worker_t *)arg;
+    hs_spi_executor_t *hs_spi_executor = worker->executor;
+
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    while (true)
+    {
+        hs_spi_executor_ctrl_t *ctrl = hs_spi_executor_next_ready(worker);
+        if (ctrl == NULL)
+        {
+            // 停止时等待所有已提交任务执行完成后退出
+            if (hs_spi_executor->stopping)
+            {
+                break;
+            }
+
+            pthread_cond_wait(&hs_spi_executor->work_cond, &hs_spi_executor->mutex);
+            continue;
+        }
+
+        // 排队的任务可能已被丢弃
+        if (ctrl->head == NULL)
+        {
+            ctrl->scheduled = false;
+            continue;
+        }
+
+        hs_spi_executor_node_t *node = hs_spi_executor_dequeue(hs_spi_executor, ctrl, NULL);
+        pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+        int result = node->job.job_cb(node->dev->hs_spi, node->job.arg);
+        if (node->job.done_cb != NULL)
+        {
+            node->job.done_cb(result, node->job.arg);
+        }
+
+        pthread_mutex_lock(&hs_spi_executor->mutex);
+        hs_spi_executor_finish(hs_spi_executor, node);
+
+        // 每次只执行一个任务后重新排队，保证同一工作线程上多个控制器轮流执行
+        if (ctrl->head != NULL)
+        {
+            hs_spi_executor_push_ready(&hs_spi_executor->workers[ctrl->home], ctrl);
+        }
+        else
+        {
+            ctrl->scheduled = false;
+        }
+    }
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief 释放线程池资源
+ *
+ * @note 调用前工作线程需已全部退出
+ *
+ * @param[in] hs_spi_executor: 线程池对象
+ */
+static void hs_spi_executor_release(hs_spi_executor_t *hs_spi_executor)
+{
+    while (hs_spi_executor->devs != NULL)
+    {
+        hs_spi_executor_dev_t *dev = hs_spi_executor->devs;
+        hs_spi_executor->devs = dev->next;
+        free(dev);
+    }
+
+    while (hs_spi_executor->clients != NULL)
+    {
+        hs_spi_executor_client_t *client = hs_spi_executor->clients;
+        hs_spi_executor->clients = client->next;
+        free(client);
+    }
+
+    while (hs_spi_executor->ctrls != NULL)
+    {
+        hs_spi_executor_ctrl_t *ctrl = hs_spi_executor->ctrls;
+        hs_spi_executor->ctrls = ctrl->next;
+        free(ctrl);
+    }
+
+    while (hs_spi_executor->free_nodes != NULL)
+    {
+        hs_spi_executor_node_t *node = hs_spi_executor->free_nodes;
+        hs_spi_executor->free_nodes = node->next;
+        free(node);
+    }
+
+    free(hs_spi_executor->workers);
+    hs_spi_executor->workers = NULL;
+    hs_spi_executor->worker_count = 0;
+    hs_spi_executor->next_home = 0;
+    hs_spi_executor->inited = false;
+}
+
+/**
+ * @brief 停止并等待工作线程退出
+ *
+ * @param[in] hs_spi_executor: 线程池对象
+ * @param[in] count          : 已启动的工作线程数量
+ */
+static void hs_spi_executor_stop(hs_spi_executor_t *hs_spi_executor, const size_t count)
+{
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    hs_spi_executor->stopping = true;
+    pthread_cond_broadcast(&hs_spi_executor->work_cond);
+    pthread_cond_broadcast(&hs_spi_executor->space_cond);
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        pthread_join(hs_spi_executor->workers[i].thread, NULL);
+    }
+}
+
+hs_spi_executor_t *hs_spi_executor_create(void)
+{
+    hs_spi_executor_t *hs_spi_executor = (hs_spi_executor_t *)malloc(sizeof(hs_spi_executor_t));
+    if (hs_spi_executor == NULL)
+    {
+        return NULL;
+    }
+
+    memset(hs_spi_executor, 0, sizeof(hs_spi_executor_t));
+    pthread_mutex_init(&hs_spi_executor->mutex, NULL);
+    pthread_cond_init(&hs_spi_executor->work_cond, NULL);
+    pthread_cond_init(&hs_spi_executor->idle_cond, NULL);
+    pthread_cond_init(&hs_spi_executor->space_cond, NULL);
+
+    return hs_spi_executor;
+}
+
+int hs_spi_executor_init(hs_spi_executor_t *hs_spi_executor, const size_t worker_count)
+{
+    if (hs_spi_executor == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    if (hs_spi_executor->inited)
+    {
+        pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+        return -2;
+    }
+
+    size_t count = worker_count;
+    if (count == 0)
+    {
+        long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+        count = cpu_count > 0 ? (size_t)cpu_count : 1;
+    }
+
+    hs_spi_executor->workers = (hs_spi_executor_worker_t *)calloc(count, sizeof(hs_spi_executor_worker_t));
+    if (hs_spi_executor->workers == NULL)
+    {
+        pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+        return -3;
+    }
+
+    hs_spi_executor->worker_count = count;
+    hs_spi_executor->stopping = false;
+    for (size_t i = 0; i < count; i++)
+    {
+        hs_spi_executor_worker_t *worker = &hs_spi_executor->workers[i];
+        worker->executor = hs_spi_executor;
+        worker->index = i;
+        if (pthread_create(&worker->thread, NULL, hs_spi_executor_worker_thread, worker) != 0)
+        {
+            pthread_mutex_unlock(&hs_spi_executor->mutex);
+            hs_spi_executor_stop(hs_spi_executor, i);
+            pthread_mutex_lock(&hs_spi_executor->mutex);
+            hs_spi_executor_release(hs_spi_executor);
+            pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+            return -4;
+        }
+    }
+
+    hs_spi_executor->inited = true;
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return 0;
+}
+
+int hs_spi_executor_destroy(hs_spi_executor_t *hs_spi_executor)
+{
+    if (hs_spi_executor == NULL)
+    {
+        return -1;
+    }
+
+    if (hs_spi_executor->inited)
+    {
+        hs_spi_executor_stop(hs_spi_executor, hs_spi_executor->worker_count);
+    }
+
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    hs_spi_executor_release(hs_spi_executor);
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    pthread_cond_destroy(&hs_spi_executor->space_cond);
+    pthread_cond_destroy(&hs_spi_executor->idle_cond);
+    pthread_cond_destroy(&hs_spi_executor->work_cond);
+    pthread_mutex_destroy(&hs_spi_executor->mutex);
+    free(hs_spi_executor);
+
+    return 0;
+}
+
+hs_spi_executor_dev_t *hs_spi_executor_add_device(hs_spi_executor_t *hs_spi_executor, hs_spi_t *hs_spi,
+                                                  const uint32_t controller_id)
+{
+    if ((hs_spi_executor == NULL) || (hs_spi == NULL))
+    {
+        return NULL;
+    }
+
+    uint32_t speed_hz = 0;
+    if (hs_spi_get_speed_hz(hs_spi, &speed_hz) < 0)
+    {
+        return NULL;
+    }
+
+    hs_spi_executor_dev_t *dev = (hs_spi_executor_dev_t *)malloc(sizeof(hs_spi_executor_dev_t));
+    if (dev == NULL)
+    {
+        return NULL;
+    }
+    memset(dev, 0, sizeof(hs_spi_executor_dev_t));
+    dev->speed_hz = speed_hz;
+
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    if (!hs_spi_executor->inited || hs_spi_executor->stopping)
+    {
+        pthread_mutex_unlock(&hs_spi_executor->mutex);
+        free(dev);
+
+        return NULL;
+    }
+
+    hs_spi_executor_ctrl_t *ctrl = hs_spi_executor->ctrls;
+    while ((ctrl != NULL) && (ctrl->id != controller_id))
+    {
+        ctrl = ctrl->next;
+    }
+
+    if (ctrl == NULL)
+    {
+        ctrl = (hs_spi_executor_ctrl_t *)malloc(sizeof(hs_spi_executor_ctrl_t));
+        if (ctrl == NULL)
+        {
+            pthread_mutex_unlock(&hs_spi_executor->mutex);
+            free(dev);
+
+            return NULL;
+        }
+
+        memset(ctrl, 0, sizeof(hs_spi_executor_ctrl_t));
+        ctrl->id = controller_id;
+        // 控制器按轮询方式分配给工作线程
+        ctrl->home = hs_spi_executor->next_home;
+        hs_spi_executor->next_home = (hs_spi_executor->next_home + 1) % hs_spi_executor->worker_count;
+        ctrl->next = hs_spi_executor->ctrls;
+        hs_spi_executor->ctrls = ctrl;
+    }
+
+    ctrl->dev_count++;
+    dev->executor = hs_spi_executor;
+    dev->hs_spi = hs_spi;
+    dev->ctrl = ctrl;
+    dev->next = hs_spi_executor->devs;
+    hs_spi_executor->devs = dev;
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return dev;
+}
+
+int hs_spi_executor_remove_device(hs_spi_executor_dev_t *hs_spi_executor_dev)
+{
+    if (hs_spi_executor_dev == NULL)
+    {
+        return -1;
+    }
+
+    hs_spi_executor_t *hs_spi_executor = hs_spi_executor_dev->executor;
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    if (hs_spi_executor_dev->removing)
+    {
+        pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+        return -2;
+    }
+
+    // 唤醒阻塞在该设备提交中的线程，使其返回失败
+    hs_spi_executor_dev->removing = true;
+    pthread_cond_broadcast(&hs_spi_executor->space_cond);
+    while ((hs_spi_executor_dev->pending > 0) || (hs_spi_executor_dev->waiters > 0))
+    {
+        pthread_cond_wait(&hs_spi_executor->idle_cond, &hs_spi_executor->mutex);
+    }
+
+    hs_spi_executor_dev_t **link = &hs_spi_executor->devs;
+    while (*link != hs_spi_executor_dev)
+    {
+        link = &(*link)->next;
+    }
+    *link = hs_spi_executor_dev->next;
+
+    // 控制器上没有设备且没有待执行任务时释放
+    hs_spi_executor_ctrl_t *ctrl = hs_spi_executor_dev->ctrl;
+    ctrl->dev_count--;
+    if ((ctrl->dev_count == 0) && !ctrl->scheduled)
+    {
+        hs_spi_executor_ctrl_t **ctrl_link = &hs_spi_executor->ctrls;
+        while (*ctrl_link != ctrl)
+        {
+            ctrl_link = &(*ctrl_link)->next;
+        }
+        *ctrl_link = ctrl->next;
+        free(ctrl);
+    }
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    free(hs_spi_executor_dev);
+
+    return 0;
+}
+
+int hs_spi_executor_set_device_limit(hs_spi_executor_dev_t *hs_spi_executor_dev, const hs_spi_executor_limit_t *limit)
+{
+    if (hs_spi_executor_dev == NULL)
+    {
+        return -1;
+    }
+
+    if ((limit != NULL) && (limit->policy > E_HS_SPI_EXECUTOR_POLICY_DROP_OLDEST))
+    {
+        return -2;
+    }
+
+    hs_spi_executor_t *hs_spi_executor = hs_spi_executor_dev->executor;
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    if (limit != NULL)
+    {
+        hs_spi_executor_dev->limit = *limit;
+    }
+    else
+    {
+        memset(&hs_spi_executor_dev->limit, 0, sizeof(hs_spi_executor_limit_t));
+    }
+    // 限制放宽后阻塞的提交线程可能可以继续
+    pthread_cond_broadcast(&hs_spi_executor->space_cond);
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return 0;
+}
+
+hs_spi_executor_client_t *hs_spi_executor_add_client(hs_spi_executor_t *hs_spi_executor,
+                                                     const hs_spi_executor_limit_t *limit)
+{
+    if (hs_spi_executor == NULL)
+    {
+        return NULL;
+    }
+
+    if ((limit != NULL) && (limit->policy > E_HS_SPI_EXECUTOR_POLICY_DROP_OLDEST))
+    {
+        return NULL;
+    }
+
+    hs_spi_executor_client_t *client = (hs_spi_executor_client_t *)malloc(sizeof(hs_spi_executor_client_t));
+    if (client == NULL)
+    {
+        return NULL;
+    }
+    memset(client, 0, sizeof(hs_spi_executor_client_t));
+    if (limit != NULL)
+    {
+        client->limit = *limit;
+    }
+
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    if (!hs_spi_executor->inited || hs_spi_executor->stopping)
+    {
+        pthread_mutex_unlock(&hs_spi_executor->mutex);
+        free(client);
+
+        return NULL;
+    }
+
+    client->executor = hs_spi_executor;
+    client->next = hs_spi_executor->clients;
+    hs_spi_executor->clients = client;
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return client;
+}
+
+int hs_spi_executor_remove_client(hs_spi_executor_client_t *hs_spi_executor_client)
+{
+    if (hs_spi_executor_client == NULL)
+    {
+        return -1;
+    }
+
+    hs_spi_executor_t *hs_spi_executor = hs_spi_executor_client->executor;
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    if (hs_spi_executor_client->removing)
+    {
+        pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+        return -2;
+    }
+
+    hs_spi_executor_client->removing = true;
+    pthread_cond_broadcast(&hs_spi_executor->space_cond);
+    while ((hs_spi_executor_client->pending > 0) || (hs_spi_executor_client->waiters > 0))
+    {
+        pthread_cond_wait(&hs_spi_executor->idle_cond, &hs_spi_executor->mutex);
+    }
+
+    hs_spi_executor_client_t **link = &hs_spi_executor->clients;
+    while (*link != hs_spi_executor_client)
+    {
+        link = &(*link)->next;
+    }
+    *link = hs_spi_executor_client->next;
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    free(hs_spi_executor_client);
+
+    return 0;
+}
+
+int hs_spi_executor_set_client_limit(hs_spi_executor_client_t *hs_spi_executor_client,
+                                     const hs_spi_executor_limit_t *limit)
+{
+    if (hs_spi_executor_client == NULL)
+    {
+        return -1;
+    }
+
+    if ((limit != NULL) && (limit->policy > E_HS_SPI_EXECUTOR_POLICY_DROP_OLDEST))
+    {
+        return -2;
+    }
+
+    hs_spi_executor_t *hs_spi_executor = hs_spi_executor_client->executor;
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    if (limit != NULL)
+    {
+        hs_spi_executor_client->limit = *limit;
+    }
+    else
+    {
+        memset(&hs_spi_executor_client->limit, 0, sizeof(hs_spi_executor_limit_t));
+    }
+    pthread_cond_broadcast(&hs_spi_executor->space_cond);
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return 0;
+}
+
+int hs_spi_executor_submit(hs_spi_executor_dev_t *hs_spi_executor_dev, const hs_spi_executor_job_t *job)
+{
+    if (hs_spi_executor_dev == NULL)
+    {
+        return -1;
+    }
+
+    hs_spi_executor_t *hs_spi_executor = hs_spi_executor_dev->executor;
+    hs_spi_executor_client_t *client = job != NULL ? job->client : NULL;
+    if ((job == NULL) || (job->job_cb == NULL) || ((client != NULL) && (client->executor != hs_spi_executor)))
+    {
+        return -2;
+    }
+
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    while (true)
+    {
+        if (hs_spi_executor_dev->removing || hs_spi_executor->stopping || ((client != NULL) && client->removing))
+        {
+            pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+            return -3;
+        }
+
+        // 先检查设备限制，再检查客户端限制，超出时按对应限制的策略处理后重新检查
+        const hs_spi_executor_limit_t *limit = NULL;
+        hs_spi_executor_dev_t *drop_dev = NULL;
+        if (hs_spi_executor_limit_exceeded(&hs_spi_executor_dev->limit, &hs_spi_executor_dev->queued, job->bus_bytes))
+        {
+            limit = &hs_spi_executor_dev->limit;
+            drop_dev = hs_spi_executor_dev;
+        }
+        else if ((client != NULL) && hs_spi_executor_limit_exceeded(&client->limit, &client->queued, job->bus_bytes))
+        {
+            limit = &client->limit;
+        }
+
+        if (limit == NULL)
+        {
+            break;
+        }
+
+        if (limit->policy == E_HS_SPI_EXECUTOR_POLICY_FAIL_FAST)
+        {
+            pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+            return -5;
+        }
+
+        if ((limit->policy == E_HS_SPI_EXECUTOR_POLICY_DROP_OLDEST) &&
+            hs_spi_executor_drop_oldest(hs_spi_executor, drop_dev, client))
+        {
+            continue;
+        }
+
+        hs_spi_executor_dev->waiters++;
+        if (client != NULL)
+        {
+            client->waiters++;
+        }
+        hs_spi_executor->space_waiters++;
+        pthread_cond_wait(&hs_spi_executor->space_cond, &hs_spi_executor->mutex);
+        hs_spi_executor->space_waiters--;
+        hs_spi_executor_dev->waiters--;
+        if (client != NULL)
+        {
+            client->waiters--;
+        }
+        if ((hs_spi_executor_dev->waiters == 0) || ((client != NULL) && (client->waiters == 0)))
+        {
+            pthread_cond_broadcast(&hs_spi_executor->idle_cond);
+        }
+    }
+
+    hs_spi_executor_node_t *node = hs_spi_executor->free_nodes;
+    if (node != NULL)
+    {
+        hs_spi_executor->free_nodes = node->next;
+    }
+    else
+    {
+        node = (hs_spi_executor_node_t *)malloc(sizeof(hs_spi_executor_node_t));
+        if (node == NULL)
+        {
+            pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+            return -4;
+        }
+    }
+
+    node->job = *job;
+    node->dev = hs_spi_executor_dev;
+    node->bus_ns = hs_spi_executor_dev->speed_hz > 0
+                       ? (uint64_t)job->bus_bytes * 8 * 1000000000ULL / hs_spi_executor_dev->speed_hz
+                       : 0;
+    node->seq = hs_spi_executor->next_seq++;
+    node->next = NULL;
+
+    hs_spi_executor_ctrl_t *ctrl = hs_spi_executor_dev->ctrl;
+    if (ctrl->tail == NULL)
+    {
+        ctrl->head = node;
+    }
+    else
+    {
+        ctrl->tail->next = node;
+    }
+    ctrl->tail = node;
+    hs_spi_executor_queue_add(&ctrl->queued, node);
+    hs_spi_executor_queue_add(&hs_spi_executor_dev->queued, node);
+    hs_spi_executor_dev->pending++;
+    if (client != NULL)
+    {
+        hs_spi_executor_queue_add(&client->queued, node);
+        client->pending++;
+    }
+
+    // 控制器空闲时放入所属工作线程的就绪队列
+    if (!ctrl->scheduled)
+    {
+        ctrl->scheduled = true;
+        hs_spi_executor_push_ready(&hs_spi_executor->workers[ctrl->home], ctrl);
+        pthread_cond_signal(&hs_spi_executor->work_cond);
+    }
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return 0;
+}
+
+/**
+ * @brief 将排队统计转换为队列积压
+ *
+ * @param[out] backlog: 队列积压
+ * @param[in]  queue  : 排队统计
+ */
+static void hs_spi_executor_fill_backlog(hs_spi_executor_backlog_t *backlog, const hs_spi_executor_queue_t *queue)
+{
+    backlog->requests = queue->requests;
+    backlog->bytes = queue->bytes;
+    backlog->bus_time_us = queue->bus_ns / 1000;
+}
+
+int hs_spi_executor_get_device_backlog(hs_spi_executor_dev_t *hs_spi_executor_dev,
+                                       hs_spi_executor_backlog_t *backlog)
+{
+    if (hs_spi_executor_dev == NULL)
+    {
+        return -1;
+    }
+
+    if (backlog == NULL)
+    {
+        return -2;
+    }
+
+    hs_spi_executor_t *hs_spi_executor = hs_spi_executor_dev->executor;
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    hs_spi_executor_fill_backlog(backlog, &hs_spi_executor_dev->queued);
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return 0;
+}
+
+int hs_spi_executor_get_controller_backlog(hs_spi_executor_dev_t *hs_spi_executor_dev,
+                                           hs_spi_executor_backlog_t *backlog)
+{
+    if (hs_spi_executor_dev == NULL)
+    {
+        return -1;
+    }
+
+    if (backlog == NULL)
+    {
+        return -2;
+    }
+
+    hs_spi_executor_t *hs_spi_executor = hs_spi_executor_dev->executor;
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    hs_spi_executor_fill_backlog(backlog, &hs_spi_executor_dev->ctrl->queued);
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return 0;
+}
+
+int hs_spi_executor_get_client_backlog(hs_spi_executor_client_t *hs_spi_executor_client,
+                                       hs_spi_executor_backlog_t *backlog)
+{
+    if (hs_spi_executor_client == NULL)
+    {
+        return -1;
+    }
+
+    if (backlog == NULL)
+    {
+        return -2;
+    }
+
+    hs_spi_executor_t *hs_spi_executor = hs_spi_executor_client->executor;
+    pthread_mutex_lock(&hs_spi_executor->mutex);
+    hs_spi_executor_fill_backlog(backlog, &hs_spi_executor_client->queued);
+    pthread_mutex_unlock(&hs_spi_executor->mutex);
+
+    return 0;
+}
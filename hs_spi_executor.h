@@ -0,0 +1,270 @@
+/**
+ * @file      hs_spi_executor.h
+ * @brief     SPI 共享工作线程池模块头文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 16:21:03
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#ifndef __HS_SPI_EXECUTOR_H
+#define __HS_SPI_EXECUTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <limits.h>
+
+#include "hs_spi.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 任务因队列已满被丢弃时传递给完成回调函数的结果（任务回调函数不应返回该值）
+#define HS_SPI_EXECUTOR_RESULT_DROPPED INT_MIN
+
+// 队列已满时的提交策略
+typedef enum hs_spi_executor_policy
+{
+    E_HS_SPI_EXECUTOR_POLICY_BLOCK = 0,   // 阻塞等待直到队列有空间
+    E_HS_SPI_EXECUTOR_POLICY_FAIL_FAST,   // 立即返回失败
+    E_HS_SPI_EXECUTOR_POLICY_DROP_OLDEST, // 丢弃最早提交且未开始执行的任务
+} hs_spi_executor_policy_e;
+
+// 队列深度限制（只统计已提交未开始执行的任务）
+typedef struct hs_spi_executor_limit
+{
+    size_t max_requests;             // 最大排队任务数，为 0 不限制
+    size_t max_bytes;                // 最大排队总线字节数，为 0 不限制
+    hs_spi_executor_policy_e policy; // 队列已满时的提交策略
+} hs_spi_executor_limit_t;
+
+// 队列积压
+typedef struct hs_spi_executor_backlog
+{
+    size_t requests;      // 排队任务数
+    size_t bytes;         // 排队总线字节数
+    uint64_t bus_time_us; // 按设备 SPI 速率估算的排队任务总线占用时间（单位：微秒）
+} hs_spi_executor_backlog_t;
+
+// 线程池对象
+typedef struct _hs_spi_executor hs_spi_executor_t;
+
+// 线程池中的设备
+typedef struct _hs_spi_executor_dev hs_spi_executor_dev_t;
+
+// 线程池客户端，用于限制同一生产者跨设备提交的任务
+typedef struct _hs_spi_executor_client hs_spi_executor_client_t;
+
+/**
+ * @brief 任务回调函数类型
+ *
+ * @note 在工作线程中执行，可调用该设备的任意 hs_spi 接口
+ *
+ * @param[in,out] hs_spi: 任务所属设备的 SPI 对象
+ * @param[in]     arg   : 用户参数
+ *
+ * @return 任务结果，传递给完成回调函数
+ */
+typedef int (*hs_spi_executor_job_cb)(hs_spi_t *hs_spi, void *arg);
+
+/**
+ * @brief 任务完成回调函数类型
+ *
+ * @note 在工作线程中执行，不能在其中移除所属设备或销毁线程池
+ *
+ * @param[in] result: 任务回调函数的返回值，任务被丢弃时为 HS_SPI_EXECUTOR_RESULT_DROPPED
+ * @param[in] arg   : 用户参数
+ */
+typedef void (*hs_spi_executor_done_cb)(int result, void *arg);
+
+// 任务
+typedef struct hs_spi_executor_job
+{
+    hs_spi_executor_job_cb job_cb;    // 任务回调函数
+    hs_spi_executor_done_cb done_cb;  // 任务完成回调函数（可以为 NULL）
+    void *arg;                        // 用户参数
+    size_t bus_bytes;                 // 预计总线传输字节数，用于按字节限制队列深度和估算积压时间
+    hs_spi_executor_client_t *client; // 所属客户端（可以为 NULL）
+} hs_spi_executor_job_t;
+
+/**
+ * @brief 创建线程池对象
+ *
+ * @return 成功: 线程池对象
+ * @return 失败: NULL
+ */
+hs_spi_executor_t *hs_spi_executor_create(void);
+
+/**
+ * @brief 初始化线程池并启动工作线程
+ *
+ * @note 1. 任意数量的设备共享固定数量的工作线程，线程数与设备数无关
+ *       2. 同一控制器上的任务串行执行（同一设备的任务按提交顺序执行），不同控制器的任务并行执行
+ *       3. 每个控制器优先由其所属工作线程处理，工作线程空闲时从其他工作线程窃取就绪的控制器
+ *
+ * @param[in,out] hs_spi_executor: 线程池对象
+ * @param[in]     worker_count   : 工作线程数量，为 0 使用 CPU 核数
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_init(hs_spi_executor_t *hs_spi_executor, const size_t worker_count);
+
+/**
+ * @brief 销毁线程池对象
+ *
+ * @note 1. 等待已提交的任务全部执行完成后停止工作线程，未移除的设备一并释放
+ *       2. 调用该函数前必须确保没有其他线程正在使用该线程池对象，否则可能导致未定义行为
+ *
+ * @param[in,out] hs_spi_executor: 线程池对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_destroy(hs_spi_executor_t *hs_spi_executor);
+
+/**
+ * @brief 向线程池添加设备
+ *
+ * @note 1. 挂在同一 SPI 控制器（如 /dev/spidevB.C 中的 B）上的设备应使用相同的控制器编号
+ *       2. 积压时间按添加设备时的 SPI 速率估算
+ *
+ * @param[in,out] hs_spi_executor: 线程池对象
+ * @param[in]     hs_spi         : 已初始化的 SPI 对象，在设备移除前不能销毁
+ * @param[in]     controller_id  : 控制器编号
+ *
+ * @return 成功: 设备对象
+ * @return 失败: NULL
+ */
+hs_spi_executor_dev_t *hs_spi_executor_add_device(hs_spi_executor_t *hs_spi_executor, hs_spi_t *hs_spi,
+                                                  const uint32_t controller_id);
+
+/**
+ * @brief 从线程池移除设备
+ *
+ * @note 1. 等待该设备已提交的任务全部执行完成后移除
+ *       2. 不能在该设备的任务回调函数或完成回调函数中调用
+ *
+ * @param[in,out] hs_spi_executor_dev: 设备对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_remove_device(hs_spi_executor_dev_t *hs_spi_executor_dev);
+
+/**
+ * @brief 设置设备队列深度限制
+ *
+ * @note 1. 未设置时不限制
+ *       2. 只影响之后的提交，已排队的任务不受影响
+ *
+ * @param[in,out] hs_spi_executor_dev: 设备对象
+ * @param[in]     limit              : 队列深度限制（NULL: 不限制）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_set_device_limit(hs_spi_executor_dev_t *hs_spi_executor_dev, const hs_spi_executor_limit_t *limit);
+
+/**
+ * @brief 向线程池添加客户端
+ *
+ * @note 任务通过 hs_spi_executor_job_t.client 关联客户端，客户端队列统计该客户端在所有设备上排队的任务
+ *
+ * @param[in,out] hs_spi_executor: 线程池对象
+ * @param[in]     limit          : 队列深度限制（NULL: 不限制）
+ *
+ * @return 成功: 客户端对象
+ * @return 失败: NULL
+ */
+hs_spi_executor_client_t *hs_spi_executor_add_client(hs_spi_executor_t *hs_spi_executor,
+                                                     const hs_spi_executor_limit_t *limit);
+
+/**
+ * @brief 从线程池移除客户端
+ *
+ * @note 1. 等待该客户端已提交的任务全部执行完成后移除
+ *       2. 不能在该客户端的任务回调函数或完成回调函数中调用
+ *
+ * @param[in,out] hs_spi_executor_client: 客户端对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_remove_client(hs_spi_executor_client_t *hs_spi_executor_client);
+
+/**
+ * @brief 设置客户端队列深度限制
+ *
+ * @param[in,out] hs_spi_executor_client: 客户端对象
+ * @param[in]     limit                 : 队列深度限制（NULL: 不限制）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_set_client_limit(hs_spi_executor_client_t *hs_spi_executor_client,
+                                     const hs_spi_executor_limit_t *limit);
+
+/**
+ * @brief 提交任务
+ *
+ * @note 1. 设备或所属客户端的队列已满时按各自的策略处理：阻塞等待、返回失败或丢弃最早的排队任务后重新检查，
+ *          被丢弃任务的完成回调函数在当前线程中以 HS_SPI_EXECUTOR_RESULT_DROPPED 调用
+ *       2. 队列为空时，总线字节数超过限制的单个任务仍被接受，避免永远无法提交
+ *       3. 阻塞策略下不能在任务回调函数或完成回调函数中提交任务，否则可能因等待自身而死锁
+ *
+ * @param[in,out] hs_spi_executor_dev: 设备对象
+ * @param[in]     job                : 任务（内容被复制，调用后可释放）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_submit(hs_spi_executor_dev_t *hs_spi_executor_dev, const hs_spi_executor_job_t *job);
+
+/**
+ * @brief 获取设备队列积压
+ *
+ * @param[in,out] hs_spi_executor_dev: 设备对象
+ * @param[out]    backlog            : 该设备排队的任务
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_get_device_backlog(hs_spi_executor_dev_t *hs_spi_executor_dev,
+                                       hs_spi_executor_backlog_t *backlog);
+
+/**
+ * @brief 获取设备所在控制器的队列积压
+ *
+ * @note 同一控制器上的任务串行执行，其总线占用时间近似为新提交任务开始执行前的等待时间（不含正在执行的任务）
+ *
+ * @param[in,out] hs_spi_executor_dev: 设备对象
+ * @param[out]    backlog            : 该设备所在控制器上所有设备排队的任务
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_get_controller_backlog(hs_spi_executor_dev_t *hs_spi_executor_dev,
+                                           hs_spi_executor_backlog_t *backlog);
+
+/**
+ * @brief 获取客户端队列积压
+ *
+ * @param[in,out] hs_spi_executor_client: 客户端对象
+ * @param[out]    backlog               : 该客户端在所有设备上排队的任务
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_executor_get_client_backlog(hs_spi_executor_client_t *hs_spi_executor_client,
+                                       hs_spi_executor_backlog_t *backlog);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HS_SPI_EXECUTOR_H
@@ -0,0 +1,1464 @@
+/**
+ * @file      hs_spi_kv.c
+ * @brief     SPI NOR Flash 日志结构键值存储模块源文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 10:12:41
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "hs_spi_kv.h"
+
+// SPI NOR Flash 命令
+#define HS_SPI_KV_CMD_READ         0x03
+#define HS_SPI_KV_CMD_PAGE_PROGRAM 0x02
+#define HS_SPI_KV_CMD_SECTOR_ERASE 0x20
+#define HS_SPI_KV_CMD_WRITE_ENABLE 0x06
+#define HS_SPI_KV_CMD_READ_STATUS  0x05
+
+// 状态寄存器忙标志
+#define HS_SPI_KV_STATUS_WIP 0x01
+// 等待 Flash 空闲超时时间（单位：毫秒）
+#define HS_SPI_KV_READY_TIMEOUT_MS 3000
+
+// 扇区头魔数（"KVS1"）及长度
+#define HS_SPI_KV_SECTOR_MAGIC      0x3153564B
+#define HS_SPI_KV_SECTOR_HEADER_LEN 12
+
+// 记录魔数（"KV"）及记录头长度
+#define HS_SPI_KV_RECORD_MAGIC      0x564B
+#define HS_SPI_KV_RECORD_HEADER_LEN 16
+// 记录标志：删除标记
+#define HS_SPI_KV_RECORD_FLAG_DELETED 0x01
+
+// 记录
+typedef struct hs_spi_kv_record
+{
+    uint8_t flags;
+    uint8_t key_len;
+    uint16_t value_len;
+    uint32_t seq;
+    const uint8_t *key;
+    const uint8_t *value;
+} hs_spi_kv_record_t;
+
+// 扇区状态
+typedef struct hs_spi_kv_sector
+{
+    bool used;           // 是否已写入扇区头
+    bool dirty;          // 空闲扇区是否可能未擦除
+    uint32_t seq;        // 扇区序号（越大越新）
+    uint32_t write_page; // 下一个可写页号
+    uint32_t live;       // 索引指向该扇区的记录数
+} hs_spi_kv_sector_t;
+
+// 索引项
+typedef struct hs_spi_kv_entry
+{
+    bool used;
+    bool deleted;
+    uint8_t key_len;
+    char key[HS_SPI_KV_MAX_KEY_LEN + 1];
+    uint32_t hash;
+    uint32_t addr; // 最新记录所在 Flash 地址
+    uint32_t seq;  // 最新记录序号
+} hs_spi_kv_entry_t;
+
+// 键值存储对象
+struct _hs_spi_kv
+{
+    hs_spi_t *hs_spi;
+    hs_spi_kv_config_t config;
+    uint32_t pages_per_sector;
+    size_t read_chunk_len; // 单条读命令最多读取的长度，受 SPI 单次最大传输长度限制
+    bool mounted;
+
+    hs_spi_kv_sector_t *sectors;
+    int head; // 当前写入扇区（-1: 无）
+    uint32_t free_count;
+    uint32_t next_seq;
+
+    hs_spi_kv_entry_t *entries;
+    size_t entry_capacity; // 2 的幂
+    size_t entry_count;
+
+    uint8_t *page_buf;   // 页编程缓冲区（命令 + 地址 + 一页数据）
+    uint8_t *record_buf; // 记录组包缓冲区
+    uint8_t *sector_buf; // 扇区读取缓冲区
+
+    pthread_mutex_t mutex;
+    pthread_mutex_t flash_mutex; // 保护 Flash 命令序列，后台擦除时不持有 mutex
+    pthread_cond_t cond;
+    pthread_t gc_thread;
+    bool gc_running;
+    bool gc_stalled; // 上次整理没有回收空间，等待新的写入后再尝试
+    int reclaiming;  // 后台线程正在擦除的扇区（-1: 无）
+};
+
+static void hs_spi_kv_put_le16(uint8_t *buf, const uint16_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+}
+
+static void hs_spi_kv_put_le32(uint8_t *buf, const uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+}
+
+static uint16_t hs_spi_kv_get_le16(const uint8_t *buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+static uint32_t hs_spi_kv_get_le32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+/**
+ * @brief 计算 CRC32（IEEE 802.3）
+ *
+ * @param[in] crc : 初始值（首次计算传入 0）
+ * @param[in] data: 数据
+ * @param[in] len : 数据长度
+ *
+ * @return CRC32 值
+ */
+static uint32_t hs_spi_kv_crc32(uint32_t crc, const uint8_t *data, const size_t len)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+/**
+ * @brief 计算键的哈希值（FNV-1a）
+ *
+ * @param[in] key    : 键
+ * @param[in] key_len: 键长度
+ *
+ * @return 哈希值
+ */
+static uint32_t hs_spi_kv_hash(const char *key, const size_t key_len)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < key_len; i++)
+    {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static bool hs_spi_kv_is_blank(const uint8_t *data, const size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (data[i] != 0xFF)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static uint32_t hs_spi_kv_sector_addr(const hs_spi_kv_t *hs_spi_kv, const uint32_t sector)
+{
+    return hs_spi_kv->config.base_addr + sector * hs_spi_kv->config.sector_size;
+}
+
+static uint32_t hs_spi_kv_addr_sector(const hs_spi_kv_t *hs_spi_kv, const uint32_t addr)
+{
+    return (addr - hs_spi_kv->config.base_addr) / hs_spi_kv->config.sector_size;
+}
+
+/**
+ * @brief 从 Flash 读取数据
+ *
+ * @note 超过 SPI 单次最大传输长度的读取会被 hs_spi 拆分为多次传输，传输间片选释放后 Flash 不再输出数据，
+ *       因此按 read_chunk_len 分段读取，每段重新发送读命令
+ *
+ * @param[in]  hs_spi_kv: 键值存储对象
+ * @param[in]  addr     : Flash 地址
+ * @param[out] data     : 读取到的数据
+ * @param[in]  len      : 读取长度
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_kv_flash_read(hs_spi_kv_t *hs_spi_kv, const uint32_t addr, uint8_t *data, const size_t len)
+{
+    size_t offset = 0;
+    while (offset < len)
+    {
+        size_t current_len = len - offset > hs_spi_kv->read_chunk_len ? hs_spi_kv->read_chunk_len : len - offset;
+        uint32_t current_addr = addr + (uint32_t)offset;
+        uint8_t cmd[4] = {HS_SPI_KV_CMD_READ, (uint8_t)(current_addr >> 16), (uint8_t)(current_addr >> 8),
+                          (uint8_t)current_addr};
+
+        pthread_mutex_lock(&hs_spi_kv->flash_mutex);
+        int ret = hs_spi_write_then_read_data(hs_spi_kv->hs_spi, cmd, sizeof(cmd), &data[offset], current_len);
+        pthread_mutex_unlock(&hs_spi_kv->flash_mutex);
+        if (ret < 0)
+        {
+            return -1;
+        }
+
+        offset += current_len;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 等待 Flash 空闲
+ *
+ * @note 调用前需持有 Flash 互斥锁
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_kv_flash_wait_ready(hs_spi_kv_t *hs_spi_kv)
+{
+    struct timespec start_time = {0};
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    uint8_t cmd = HS_SPI_KV_CMD_READ_STATUS;
+    while (true)
+    {
+        uint8_t status = 0;
+        if (hs_spi_write_then_read_data(hs_spi_kv->hs_spi, &cmd, 1, &status, 1) < 0)
+        {
+            return -1;
+        }
+
+        if ((status & HS_SPI_KV_STATUS_WIP) == 0)
+        {
+            return 0;
+        }
+
+        struct timespec now_time = {0};
+        clock_gettime(CLOCK_MONOTONIC, &now_time);
+        long elapsed_ms =
+            (now_time.tv_sec - start_time.tv_sec) * 1000 + (now_time.tv_nsec - start_time.tv_nsec) / 1000000;
+        if (elapsed_ms > HS_SPI_KV_READY_TIMEOUT_MS)
+        {
+            return -2;
+        }
+
+        usleep(100);
+    }
+}
+
+static int hs_spi_kv_flash_write_enable(hs_spi_kv_t *hs_spi_kv)
+{
+    uint8_t cmd = HS_SPI_KV_CMD_WRITE_ENABLE;
+
+    return hs_spi_write_data(hs_spi_kv->hs_spi, &cmd, 1) < 0 ? -1 : 0;
+}
+
+/**
+ * @brief 向 Flash 页编程
+ *
+ * @note 编程数据不能跨页
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ * @param[in] addr     : Flash 地址
+ * @param[in] data     : 待编程数据
+ * @param[in] len      : 待编程数据长度
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_kv_flash_program(hs_spi_kv_t *hs_spi_kv, const uint32_t addr, const uint8_t *data,
+                                   const size_t len)
+{
+    pthread_mutex_lock(&hs_spi_kv->flash_mutex);
+    if (hs_spi_kv_flash_write_enable(hs_spi_kv) < 0)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->flash_mutex);
+
+        return -1;
+    }
+
+    hs_spi_kv->page_buf[0] = HS_SPI_KV_CMD_PAGE_PROGRAM;
+    hs_spi_kv->page_buf[1] = (uint8_t)(addr >> 16);
+    hs_spi_kv->page_buf[2] = (uint8_t)(addr >> 8);
+    hs_spi_kv->page_buf[3] = (uint8_t)addr;
+    memcpy(&hs_spi_kv->page_buf[4], data, len);
+    if (hs_spi_write_data(hs_spi_kv->hs_spi, hs_spi_kv->page_buf, len + 4) < 0)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->flash_mutex);
+
+        return -2;
+    }
+
+    int ret = hs_spi_kv_flash_wait_ready(hs_spi_kv);
+    pthread_mutex_unlock(&hs_spi_kv->flash_mutex);
+
+    return ret < 0 ? -3 : 0;
+}
+
+/**
+ * @brief 擦除 Flash 扇区
+ *
+ * @note 只访问 Flash，可以在不持有 mutex 的情况下调用
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ * @param[in] sector   : 扇区号（相对存储区）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_kv_flash_erase(hs_spi_kv_t *hs_spi_kv, const uint32_t sector)
+{
+    uint32_t addr = hs_spi_kv_sector_addr(hs_spi_kv, sector);
+    uint8_t cmd[4] = {HS_SPI_KV_CMD_SECTOR_ERASE, (uint8_t)(addr >> 16), (uint8_t)(addr >> 8), (uint8_t)addr};
+
+    pthread_mutex_lock(&hs_spi_kv->flash_mutex);
+    if (hs_spi_kv_flash_write_enable(hs_spi_kv) < 0)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->flash_mutex);
+
+        return -1;
+    }
+
+    if (hs_spi_write_data(hs_spi_kv->hs_spi, cmd, sizeof(cmd)) < 0)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->flash_mutex);
+
+        return -2;
+    }
+
+    int ret = hs_spi_kv_flash_wait_ready(hs_spi_kv);
+    pthread_mutex_unlock(&hs_spi_kv->flash_mutex);
+
+    return ret < 0 ? -3 : 0;
+}
+
+/**
+ * @brief 解析记录
+ *
+ * @param[in]  hs_spi_kv: 键值存储对象
+ * @param[in]  data     : 记录所在页数据
+ * @param[out] record   : 解析得到的记录
+ *
+ * @return 0 : 成功
+ * @return <0: 失败（空白页、不完整或校验错误）
+ */
+static int hs_spi_kv_record_parse(const hs_spi_kv_t *hs_spi_kv, const uint8_t *data, hs_spi_kv_record_t *record)
+{
+    if (hs_spi_kv_get_le16(&data[0]) != HS_SPI_KV_RECORD_MAGIC)
+    {
+        return -1;
+    }
+
+    record->flags = data[2];
+    record->key_len = data[3];
+    record->value_len = hs_spi_kv_get_le16(&data[4]);
+    record->seq = hs_spi_kv_get_le32(&data[8]);
+    if ((record->key_len == 0) || (record->key_len > HS_SPI_KV_MAX_KEY_LEN) ||
+        ((size_t)HS_SPI_KV_RECORD_HEADER_LEN + record->key_len + record->value_len > hs_spi_kv->config.page_size))
+    {
+        return -2;
+    }
+
+    uint32_t crc = hs_spi_kv_crc32(0, data, 12);
+    crc = hs_spi_kv_crc32(crc, &data[HS_SPI_KV_RECORD_HEADER_LEN], record->key_len + record->value_len);
+    if (crc != hs_spi_kv_get_le32(&data[12]))
+    {
+        return -3;
+    }
+
+    record->key = &data[HS_SPI_KV_RECORD_HEADER_LEN];
+    record->value = &data[HS_SPI_KV_RECORD_HEADER_LEN + record->key_len];
+
+    return 0;
+}
+
+/**
+ * @brief 组包记录
+ *
+ * @param[out] buf      : 记录缓冲区
+ * @param[in]  flags    : 记录标志
+ * @param[in]  seq      : 记录序号
+ * @param[in]  key      : 键
+ * @param[in]  key_len  : 键长度
+ * @param[in]  value    : 值
+ * @param[in]  value_len: 值长度
+ *
+ * @return 记录长度
+ */
+static size_t hs_spi_kv_record_build(uint8_t *buf, const uint8_t flags, const uint32_t seq, const char *key,
+                                     const size_t key_len, const uint8_t *value, const size_t value_len)
+{
+    hs_spi_kv_put_le16(&buf[0], HS_SPI_KV_RECORD_MAGIC);
+    buf[2] = flags;
+    buf[3] = (uint8_t)key_len;
+    hs_spi_kv_put_le16(&buf[4], (uint16_t)value_len);
+    hs_spi_kv_put_le16(&buf[6], 0xFFFF);
+    hs_spi_kv_put_le32(&buf[8], seq);
+    memcpy(&buf[HS_SPI_KV_RECORD_HEADER_LEN], key, key_len);
+    if (value_len > 0)
+    {
+        memcpy(&buf[HS_SPI_KV_RECORD_HEADER_LEN + key_len], value, value_len);
+    }
+
+    uint32_t crc = hs_spi_kv_crc32(0, buf, 12);
+    crc = hs_spi_kv_crc32(crc, &buf[HS_SPI_KV_RECORD_HEADER_LEN], key_len + value_len);
+    hs_spi_kv_put_le32(&buf[12], crc);
+
+    return HS_SPI_KV_RECORD_HEADER_LEN + key_len + value_len;
+}
+
+/**
+ * @brief 查找索引项
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ * @param[in] key      : 键
+ * @param[in] key_len  : 键长度
+ * @param[in] hash     : 键的哈希值
+ *
+ * @return 成功: 索引项
+ * @return 失败: NULL
+ */
+static hs_spi_kv_entry_t *hs_spi_kv_index_find(hs_spi_kv_t *hs_spi_kv, const char *key, const size_t key_len,
+                                               const uint32_t hash)
+{
+    size_t mask = hs_spi_kv->entry_capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        hs_spi_kv_entry_t *entry = &hs_spi_kv->entries[i];
+        if (!entry->used)
+        {
+            return NULL;
+        }
+
+        if ((entry->hash == hash) && (entry->key_len == key_len) && (memcmp(entry->key, key, key_len) == 0))
+        {
+            return entry;
+        }
+    }
+}
+
+/**
+ * @brief 插入索引项
+ *
+ * @note 调用前需确认键不存在且索引未满
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ * @param[in] key      : 键
+ * @param[in] key_len  : 键长度
+ * @param[in] hash     : 键的哈希值
+ *
+ * @return 新的索引项
+ */
+static hs_spi_kv_entry_t *hs_spi_kv_index_insert(hs_spi_kv_t *hs_spi_kv, const char *key, const size_t key_len,
+                                                 const uint32_t hash)
+{
+    size_t mask = hs_spi_kv->entry_capacity - 1;
+    size_t i = hash & mask;
+    while (hs_spi_kv->entries[i].used)
+    {
+        i = (i + 1) & mask;
+    }
+
+    hs_spi_kv_entry_t *entry = &hs_spi_kv->entries[i];
+    memset(entry, 0, sizeof(hs_spi_kv_entry_t));
+    entry->used = true;
+    entry->key_len = (uint8_t)key_len;
+    memcpy(entry->key, key, key_len);
+    entry->hash = hash;
+    hs_spi_kv->entry_count++;
+
+    return entry;
+}
+
+/**
+ * @brief 删除索引项
+ *
+ * @note 线性探测表使用后移删除，不留删除标记
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ * @param[in] entry    : 待删除的索引项
+ */
+static void hs_spi_kv_index_remove(hs_spi_kv_t *hs_spi_kv, hs_spi_kv_entry_t *entry)
+{
+    size_t mask = hs_spi_kv->entry_capacity - 1;
+    size_t i = (size_t)(entry - hs_spi_kv->entries);
+    size_t j = i;
+    while (true)
+    {
+        j = (j + 1) & mask;
+        if (!hs_spi_kv->entries[j].used)
+        {
+            break;
+        }
+
+        // 该项的理想位置不在 (i, j] 区间内时，可以前移到空位 i
+        size_t k = hs_spi_kv->entries[j].hash & mask;
+        bool movable = (i <= j) ? ((k <= i) || (k > j)) : ((k <= i) && (k > j));
+        if (movable)
+        {
+            hs_spi_kv->entries[i] = hs_spi_kv->entries[j];
+            i = j;
+        }
+    }
+
+    hs_spi_kv->entries[i].used = false;
+    hs_spi_kv->entry_count--;
+}
+
+/**
+ * @brief 打开新的写入扇区
+ *
+ * @note 从当前写入扇区的下一个扇区开始按环形顺序查找空闲扇区
+ *
+ * @param[in] hs_spi_kv    : 键值存储对象
+ * @param[in] allow_reserve: 是否允许使用保留的最后一个空闲扇区（仅整理时允许）
+ *
+ * @return 0 : 成功
+ * @return -1: 没有可用的空闲扇区
+ * @return <-1: Flash 操作失败
+ */
+static int hs_spi_kv_open_sector(hs_spi_kv_t *hs_spi_kv, const bool allow_reserve)
+{
+    if ((hs_spi_kv->free_count == 0) || (!allow_reserve && (hs_spi_kv->free_count <= 1)))
+    {
+        return -1;
+    }
+
+    uint32_t sector_count = hs_spi_kv->config.sector_count;
+    uint32_t start = hs_spi_kv->head < 0 ? 0 : (uint32_t)hs_spi_kv->head + 1;
+    uint32_t sector = 0;
+    for (uint32_t i = 0; i < sector_count; i++)
+    {
+        sector = (start + i) % sector_count;
+        if (!hs_spi_kv->sectors[sector].used)
+        {
+            break;
+        }
+    }
+
+    // 挂载时未确认已擦除的扇区，逐页检查是否空白，非空白则擦除
+    if (hs_spi_kv->sectors[sector].dirty)
+    {
+        uint32_t addr = hs_spi_kv_sector_addr(hs_spi_kv, sector);
+        bool blank = true;
+        for (uint32_t page = 0; blank && (page < hs_spi_kv->pages_per_sector); page++)
+        {
+            if (hs_spi_kv_flash_read(hs_spi_kv, addr + page * hs_spi_kv->config.page_size, hs_spi_kv->page_buf,
+                                     hs_spi_kv->config.page_size) < 0)
+            {
+                return -2;
+            }
+
+            blank = hs_spi_kv_is_blank(hs_spi_kv->page_buf, hs_spi_kv->config.page_size);
+        }
+
+        if (!blank && (hs_spi_kv_flash_erase(hs_spi_kv, sector) < 0))
+        {
+            return -3;
+        }
+
+        hs_spi_kv->sectors[sector].dirty = false;
+    }
+
+    uint32_t seq = hs_spi_kv->next_seq++;
+    uint8_t header[HS_SPI_KV_SECTOR_HEADER_LEN] = {0};
+    hs_spi_kv_put_le32(&header[0], HS_SPI_KV_SECTOR_MAGIC);
+    hs_spi_kv_put_le32(&header[4], seq);
+    hs_spi_kv_put_le32(&header[8], hs_spi_kv_crc32(0, header, 8));
+
+    // 无论扇区头是否写入成功，该扇区都不再视为干净的空闲扇区
+    hs_spi_kv->sectors[sector].used = true;
+    hs_spi_kv->sectors[sector].seq = seq;
+    hs_spi_kv->sectors[sector].write_page = 1;
+    hs_spi_kv->sectors[sector].live = 0;
+    hs_spi_kv->free_count--;
+    hs_spi_kv->head = (int)sector;
+
+    if ((hs_spi_kv->config.gc_free_sectors > 0) && (hs_spi_kv->free_count < hs_spi_kv->config.gc_free_sectors))
+    {
+        pthread_cond_signal(&hs_spi_kv->cond);
+    }
+
+    if (hs_spi_kv_flash_program(hs_spi_kv, hs_spi_kv_sector_addr(hs_spi_kv, sector), header, sizeof(header)) < 0)
+    {
+        hs_spi_kv->sectors[sector].write_page = hs_spi_kv->pages_per_sector;
+
+        return -4;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 追加记录到当前写入扇区
+ *
+ * @param[in]  hs_spi_kv    : 键值存储对象
+ * @param[in]  record       : 记录数据
+ * @param[in]  record_len   : 记录长度
+ * @param[in]  allow_reserve: 是否允许使用保留扇区
+ * @param[out] addr         : 记录写入的 Flash 地址
+ *
+ * @return 0 : 成功
+ * @return -1: 空间不足
+ * @return <-1: Flash 操作失败
+ */
+static int hs_spi_kv_append(hs_spi_kv_t *hs_spi_kv, const uint8_t *record, const size_t record_len,
+                            const bool allow_reserve, uint32_t *addr)
+{
+    if ((hs_spi_kv->head < 0) || (hs_spi_kv->sectors[hs_spi_kv->head].write_page >= hs_spi_kv->pages_per_sector))
+    {
+        int ret = hs_spi_kv_open_sector(hs_spi_kv, allow_reserve);
+        if (ret < 0)
+        {
+            return ret == -1 ? -1 : -2;
+        }
+    }
+
+    hs_spi_kv_sector_t *sector = &hs_spi_kv->sectors[hs_spi_kv->head];
+    *addr = hs_spi_kv_sector_addr(hs_spi_kv, (uint32_t)hs_spi_kv->head) + sector->write_page * hs_spi_kv->config.page_size;
+    // 先占用该页，编程失败的页不再重复使用
+    sector->write_page++;
+    if (hs_spi_kv_flash_program(hs_spi_kv, *addr, record, record_len) < 0)
+    {
+        return -3;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 搬移最旧扇区中的有效记录
+ *
+ * @note 1. 调用前需持有互斥锁
+ *       2. 成功后该扇区不再有索引指向的记录，需擦除后调用 hs_spi_kv_compact_finish_locked() 回收
+ *       3. 有效记录重新读取时校验失败则无法搬移，返回失败且该扇区不能擦除，已搬移的记录保持有效，之后再次整理时重试
+ *
+ * @param[in]  hs_spi_kv: 键值存储对象
+ * @param[out] victim   : 被整理的扇区
+ * @param[out] copied   : 搬移的记录数
+ *
+ * @return 0 : 成功
+ * @return -1: 没有可整理的扇区
+ * @return -4: 有效记录未能全部搬移
+ * @return <-1: Flash 操作失败
+ */
+static int hs_spi_kv_compact_move_locked(hs_spi_kv_t *hs_spi_kv, uint32_t *victim, uint32_t *copied)
+{
+    *copied = 0;
+
+    int oldest = -1;
+    for (uint32_t i = 0; i < hs_spi_kv->config.sector_count; i++)
+    {
+        if (!hs_spi_kv->sectors[i].used || ((int)i == hs_spi_kv->head))
+        {
+            continue;
+        }
+
+        if ((oldest < 0) || (hs_spi_kv->sectors[i].seq < hs_spi_kv->sectors[oldest].seq))
+        {
+            oldest = (int)i;
+        }
+    }
+
+    if (oldest < 0)
+    {
+        return -1;
+    }
+
+    *victim = (uint32_t)oldest;
+    hs_spi_kv_sector_t *sector = &hs_spi_kv->sectors[oldest];
+    // 没有有效记录的扇区直接擦除
+    if (sector->live == 0)
+    {
+        return 0;
+    }
+
+    uint32_t sector_addr = hs_spi_kv_sector_addr(hs_spi_kv, (uint32_t)oldest);
+    if (hs_spi_kv_flash_read(hs_spi_kv, sector_addr, hs_spi_kv->sector_buf, hs_spi_kv->config.sector_size) < 0)
+    {
+        return -2;
+    }
+
+    for (uint32_t page = 1; page < sector->write_page; page++)
+    {
+        uint8_t *data = &hs_spi_kv->sector_buf[page * hs_spi_kv->config.page_size];
+        hs_spi_kv_record_t record = {0};
+        if (hs_spi_kv_record_parse(hs_spi_kv, data, &record) < 0)
+        {
+            continue;
+        }
+
+        uint32_t addr = sector_addr + page * hs_spi_kv->config.page_size;
+        const char *key = (const char *)record.key;
+        hs_spi_kv_entry_t *entry =
+            hs_spi_kv_index_find(hs_spi_kv, key, record.key_len, hs_spi_kv_hash(key, record.key_len));
+        if ((entry == NULL) || (entry->addr != addr))
+        {
+            continue;
+        }
+
+        // 删除标记位于最旧扇区时，该键更早的记录都已被擦除或随本扇区擦除，可以直接丢弃
+        if (entry->deleted)
+        {
+            hs_spi_kv_index_remove(hs_spi_kv, entry);
+            sector->live--;
+            continue;
+        }
+
+        // 原样搬移，保留原序号，搬移过程中掉电时新旧两份记录内容一致
+        uint32_t new_addr = 0;
+        size_t record_len = HS_SPI_KV_RECORD_HEADER_LEN + record.key_len + record.value_len;
+        if (hs_spi_kv_append(hs_spi_kv, data, record_len, true, &new_addr) < 0)
+        {
+            return -3;
+        }
+
+        entry->addr = new_addr;
+        sector->live--;
+        hs_spi_kv->sectors[hs_spi_kv->head].live++;
+        (*copied)++;
+    }
+
+    // 仍有索引指向该扇区的记录（读取到的数据校验失败），擦除会丢失这些键
+    if (sector->live > 0)
+    {
+        return -4;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 根据擦除结果回收已搬移完成的扇区
+ *
+ * @note 调用前需持有互斥锁
+ *
+ * @param[in]  hs_spi_kv: 键值存储对象
+ * @param[in]  victim   : 被整理的扇区
+ * @param[in]  copied   : 搬移的记录数
+ * @param[in]  erase_ret: 擦除结果
+ * @param[out] reclaimed: 回收的页数
+ *
+ * @return 0 : 成功
+ * @return <0: 擦除失败，扇区作为未确认擦除的空闲扇区回收
+ */
+static int hs_spi_kv_compact_finish_locked(hs_spi_kv_t *hs_spi_kv, const uint32_t victim, const uint32_t copied,
+                                           const int erase_ret, uint32_t *reclaimed)
+{
+    hs_spi_kv_sector_t *sector = &hs_spi_kv->sectors[victim];
+    uint32_t used_pages = sector->write_page - 1;
+
+    *reclaimed = 0;
+    sector->used = false;
+    hs_spi_kv->free_count++;
+    if (erase_ret < 0)
+    {
+        sector->dirty = true;
+
+        return -1;
+    }
+
+    sector->dirty = false;
+    sector->seq = 0;
+    sector->write_page = 0;
+    sector->live = 0;
+    *reclaimed = used_pages > copied ? used_pages - copied : 0;
+
+    return 0;
+}
+
+/**
+ * @brief 整理最旧的扇区
+ *
+ * @note 1. 调用前需持有互斥锁
+ *       2. 后台线程正在擦除扇区时先等待其完成
+ *
+ * @param[in]  hs_spi_kv: 键值存储对象
+ * @param[out] reclaimed: 回收的页数
+ *
+ * @return 0 : 成功
+ * @return -1: 没有可整理的扇区
+ * @return <-1: Flash 操作失败
+ */
+static int hs_spi_kv_compact_locked(hs_spi_kv_t *hs_spi_kv, uint32_t *reclaimed)
+{
+    *reclaimed = 0;
+    while (hs_spi_kv->reclaiming >= 0)
+    {
+        pthread_cond_wait(&hs_spi_kv->cond, &hs_spi_kv->mutex);
+    }
+
+    uint32_t victim = 0;
+    uint32_t copied = 0;
+    int ret = hs_spi_kv_compact_move_locked(hs_spi_kv, &victim, &copied);
+    if (ret < 0)
+    {
+        return ret;
+    }
+
+    int erase_ret = hs_spi_kv_flash_erase(hs_spi_kv, victim);
+
+    return hs_spi_kv_compact_finish_locked(hs_spi_kv, victim, copied, erase_ret, reclaimed) < 0 ? -4 : 0;
+}
+
+/**
+ * @brief 后台整理线程
+ *
+ * @note 每次整理一个扇区：持有互斥锁搬移有效记录，释放互斥锁擦除扇区，前台操作只在搬移期间等待
+ *
+ * @param[in] arg: 键值存储对象
+ *
+ * @return NULL
+ */
+static void *hs_spi_kv_gc_thread(void *arg)
+{
+    hs_spi_kv_t *hs_spi_kv = (hs_spi_kv_t *)arg;
+
+    pthread_mutex_lock(&hs_spi_kv->mutex);
+    while (hs_spi_kv->gc_running)
+    {
+        if (!hs_spi_kv->gc_stalled && (hs_spi_kv->free_count < hs_spi_kv->config.gc_free_sectors))
+        {
+            uint32_t victim = 0;
+            uint32_t copied = 0;
+            if (hs_spi_kv_compact_move_locked(hs_spi_kv, &victim, &copied) < 0)
+            {
+                hs_spi_kv->gc_stalled = true;
+                continue;
+            }
+
+            // 被整理的扇区已没有有效记录且不会被选为写入扇区，擦除期间不持有互斥锁
+            hs_spi_kv->reclaiming = (int)victim;
+            pthread_mutex_unlock(&hs_spi_kv->mutex);
+            int erase_ret = hs_spi_kv_flash_erase(hs_spi_kv, victim);
+            pthread_mutex_lock(&hs_spi_kv->mutex);
+            hs_spi_kv->reclaiming = -1;
+            pthread_cond_broadcast(&hs_spi_kv->cond);
+
+            uint32_t reclaimed = 0;
+            if ((hs_spi_kv_compact_finish_locked(hs_spi_kv, victim, copied, erase_ret, &reclaimed) < 0) ||
+                (reclaimed == 0))
+            {
+                hs_spi_kv->gc_stalled = true;
+            }
+
+            continue;
+        }
+
+        pthread_cond_wait(&hs_spi_kv->cond, &hs_spi_kv->mutex);
+    }
+    pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief 停止后台整理线程
+ *
+ * @note 调用前不能持有互斥锁
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ */
+static void hs_spi_kv_gc_stop(hs_spi_kv_t *hs_spi_kv)
+{
+    pthread_mutex_lock(&hs_spi_kv->mutex);
+    if (!hs_spi_kv->gc_running)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return;
+    }
+
+    hs_spi_kv->gc_running = false;
+    pthread_cond_broadcast(&hs_spi_kv->cond);
+    pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+    pthread_join(hs_spi_kv->gc_thread, NULL);
+}
+
+/**
+ * @brief 释放挂载时申请的资源
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ */
+static void hs_spi_kv_release(hs_spi_kv_t *hs_spi_kv)
+{
+    free(hs_spi_kv->sectors);
+    free(hs_spi_kv->entries);
+    free(hs_spi_kv->page_buf);
+    free(hs_spi_kv->record_buf);
+    free(hs_spi_kv->sector_buf);
+    hs_spi_kv->sectors = NULL;
+    hs_spi_kv->entries = NULL;
+    hs_spi_kv->page_buf = NULL;
+    hs_spi_kv->record_buf = NULL;
+    hs_spi_kv->sector_buf = NULL;
+    hs_spi_kv->entry_capacity = 0;
+    hs_spi_kv->entry_count = 0;
+    hs_spi_kv->head = -1;
+    hs_spi_kv->free_count = 0;
+    hs_spi_kv->next_seq = 1;
+    hs_spi_kv->mounted = false;
+}
+
+/**
+ * @brief 扫描存储区并重建索引
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_kv_scan(hs_spi_kv_t *hs_spi_kv)
+{
+    uint32_t sector_count = hs_spi_kv->config.sector_count;
+    uint32_t *order = (uint32_t *)malloc(sector_count * sizeof(uint32_t));
+    if (order == NULL)
+    {
+        return -1;
+    }
+    uint32_t used_count = 0;
+
+    // 读取扇区头，按序号排序已使用扇区
+    for (uint32_t i = 0; i < sector_count; i++)
+    {
+        uint8_t header[HS_SPI_KV_SECTOR_HEADER_LEN] = {0};
+        if (hs_spi_kv_flash_read(hs_spi_kv, hs_spi_kv_sector_addr(hs_spi_kv, i), header, sizeof(header)) < 0)
+        {
+            free(order);
+
+            return -2;
+        }
+
+        hs_spi_kv_sector_t *sector = &hs_spi_kv->sectors[i];
+        if ((hs_spi_kv_get_le32(&header[0]) != HS_SPI_KV_SECTOR_MAGIC) ||
+            (hs_spi_kv_get_le32(&header[8]) != hs_spi_kv_crc32(0, header, 8)))
+        {
+            sector->dirty = true;
+            hs_spi_kv->free_count++;
+            continue;
+        }
+
+        sector->used = true;
+        sector->seq = hs_spi_kv_get_le32(&header[4]);
+        if (sector->seq >= hs_spi_kv->next_seq)
+        {
+            hs_spi_kv->next_seq = sector->seq + 1;
+        }
+
+        uint32_t pos = used_count++;
+        while ((pos > 0) && (hs_spi_kv->sectors[order[pos - 1]].seq > sector->seq))
+        {
+            order[pos] = order[pos - 1];
+            pos--;
+        }
+        order[pos] = i;
+    }
+
+    // 从旧到新顺序扫描记录，每个扇区一次读取
+    for (uint32_t i = 0; i < used_count; i++)
+    {
+        uint32_t sector_index = order[i];
+        hs_spi_kv_sector_t *sector = &hs_spi_kv->sectors[sector_index];
+        uint32_t sector_addr = hs_spi_kv_sector_addr(hs_spi_kv, sector_index);
+        if (hs_spi_kv_flash_read(hs_spi_kv, sector_addr, hs_spi_kv->sector_buf, hs_spi_kv->config.sector_size) < 0)
+        {
+            free(order);
+
+            return -3;
+        }
+
+        // 编程失败的页可能保持空白，之后的页仍有记录，需检查所有页并从最后一个非空白页之后继续写入
+        sector->write_page = 1;
+        for (uint32_t page = 1; page < hs_spi_kv->pages_per_sector; page++)
+        {
+            uint8_t *data = &hs_spi_kv->sector_buf[page * hs_spi_kv->config.page_size];
+            if (hs_spi_kv_is_blank(data, hs_spi_kv->config.page_size))
+            {
+                continue;
+            }
+
+            sector->write_page = page + 1;
+
+            // 不完整或校验错误的记录（如写入时掉电）直接跳过
+            hs_spi_kv_record_t record = {0};
+            if (hs_spi_kv_record_parse(hs_spi_kv, data, &record) < 0)
+            {
+                continue;
+            }
+
+            if (record.seq >= hs_spi_kv->next_seq)
+            {
+                hs_spi_kv->next_seq = record.seq + 1;
+            }
+
+            const char *key = (const char *)record.key;
+            uint32_t hash = hs_spi_kv_hash(key, record.key_len);
+            hs_spi_kv_entry_t *entry = hs_spi_kv_index_find(hs_spi_kv, key, record.key_len, hash);
+            if (entry == NULL)
+            {
+                if (hs_spi_kv->entry_count >= hs_spi_kv->config.max_keys)
+                {
+                    free(order);
+
+                    return -4;
+                }
+
+                entry = hs_spi_kv_index_insert(hs_spi_kv, key, record.key_len, hash);
+            }
+            // 序号相同说明是整理时搬移的副本，以后扫描到的为准
+            else if (record.seq < entry->seq)
+            {
+                continue;
+            }
+
+            entry->addr = sector_addr + page * hs_spi_kv->config.page_size;
+            entry->seq = record.seq;
+            entry->deleted = (record.flags & HS_SPI_KV_RECORD_FLAG_DELETED) != 0;
+        }
+    }
+
+    for (size_t i = 0; i < hs_spi_kv->entry_capacity; i++)
+    {
+        if (hs_spi_kv->entries[i].used)
+        {
+            hs_spi_kv->sectors[hs_spi_kv_addr_sector(hs_spi_kv, hs_spi_kv->entries[i].addr)].live++;
+        }
+    }
+
+    hs_spi_kv->head = used_count > 0 ? (int)order[used_count - 1] : -1;
+    free(order);
+
+    return 0;
+}
+
+/**
+ * @brief 追加一条记录并更新索引
+ *
+ * @note 调用前需持有互斥锁
+ *
+ * @param[in] hs_spi_kv: 键值存储对象
+ * @param[in] key      : 键
+ * @param[in] key_len  : 键长度
+ * @param[in] flags    : 记录标志
+ * @param[in] value    : 值
+ * @param[in] value_len: 值长度
+ *
+ * @return 0 : 成功
+ * @return -1: 键不存在（删除时）
+ * @return -2: 键数量已达上限
+ * @return -3: 存储空间不足
+ * @return -4: Flash 操作失败
+ */
+static int hs_spi_kv_write_locked(hs_spi_kv_t *hs_spi_kv, const char *key, const size_t key_len, const uint8_t flags,
+                                  const uint8_t *value, const size_t value_len)
+{
+    uint32_t hash = hs_spi_kv_hash(key, key_len);
+    hs_spi_kv_entry_t *entry = hs_spi_kv_index_find(hs_spi_kv, key, key_len, hash);
+    if ((flags & HS_SPI_KV_RECORD_FLAG_DELETED) && ((entry == NULL) || entry->deleted))
+    {
+        return -1;
+    }
+
+    if ((entry == NULL) && (hs_spi_kv->entry_count >= hs_spi_kv->config.max_keys))
+    {
+        return -2;
+    }
+
+    uint32_t seq = hs_spi_kv->next_seq++;
+    size_t record_len = hs_spi_kv_record_build(hs_spi_kv->record_buf, flags, seq, key, key_len, value, value_len);
+
+    // 空间不足时同步整理，最多整理一轮
+    uint32_t addr = 0;
+    for (uint32_t attempt = 0;; attempt++)
+    {
+        int ret = hs_spi_kv_append(hs_spi_kv, hs_spi_kv->record_buf, record_len, false, &addr);
+        if (ret == 0)
+        {
+            break;
+        }
+
+        if (ret != -1)
+        {
+            return -4;
+        }
+
+        uint32_t reclaimed = 0;
+        if ((attempt >= hs_spi_kv->config.sector_count) || (hs_spi_kv_compact_locked(hs_spi_kv, &reclaimed) < 0))
+        {
+            return -3;
+        }
+    }
+
+    // 整理可能移动或删除索引项，需要重新查找
+    entry = hs_spi_kv_index_find(hs_spi_kv, key, key_len, hash);
+    if (entry == NULL)
+    {
+        entry = hs_spi_kv_index_insert(hs_spi_kv, key, key_len, hash);
+    }
+    else
+    {
+        hs_spi_kv->sectors[hs_spi_kv_addr_sector(hs_spi_kv, entry->addr)].live--;
+    }
+
+    entry->addr = addr;
+    entry->seq = seq;
+    entry->deleted = (flags & HS_SPI_KV_RECORD_FLAG_DELETED) != 0;
+    hs_spi_kv->sectors[hs_spi_kv_addr_sector(hs_spi_kv, addr)].live++;
+    hs_spi_kv->gc_stalled = false;
+
+    return 0;
+}
+
+hs_spi_kv_t *hs_spi_kv_create(void)
+{
+    hs_spi_kv_t *hs_spi_kv = (hs_spi_kv_t *)malloc(sizeof(hs_spi_kv_t));
+    if (hs_spi_kv == NULL)
+    {
+        return NULL;
+    }
+
+    memset(hs_spi_kv, 0, sizeof(hs_spi_kv_t));
+    hs_spi_kv->head = -1;
+    hs_spi_kv->next_seq = 1;
+    hs_spi_kv->reclaiming = -1;
+    pthread_mutex_init(&hs_spi_kv->mutex, NULL);
+    pthread_mutex_init(&hs_spi_kv->flash_mutex, NULL);
+    pthread_cond_init(&hs_spi_kv->cond, NULL);
+
+    return hs_spi_kv;
+}
+
+int hs_spi_kv_mount(hs_spi_kv_t *hs_spi_kv, hs_spi_t *hs_spi, const hs_spi_kv_config_t *config)
+{
+    if (hs_spi_kv == NULL)
+    {
+        return -1;
+    }
+
+    if (hs_spi == NULL)
+    {
+        return -2;
+    }
+
+    if (config == NULL)
+    {
+        return -3;
+    }
+
+    size_t max_transfer_len = 0;
+    if (hs_spi_get_max_transfer_len(hs_spi, &max_transfer_len) < 0)
+    {
+        return -2;
+    }
+
+    hs_spi_kv_config_t cfg = *config;
+    cfg.sector_size = cfg.sector_size == 0 ? 4096 : cfg.sector_size;
+    cfg.page_size = cfg.page_size == 0 ? 256 : cfg.page_size;
+    cfg.max_keys = cfg.max_keys == 0 ? 256 : cfg.max_keys;
+    // 页编程的命令、地址与一页数据需在一次传输内完成
+    if ((cfg.page_size < HS_SPI_KV_RECORD_HEADER_LEN + HS_SPI_KV_MAX_KEY_LEN) || (cfg.page_size > 0xFFFF) ||
+        (cfg.page_size + 4 > max_transfer_len) ||
+        (cfg.sector_size % cfg.page_size != 0) || (cfg.sector_size / cfg.page_size < 2) || (cfg.sector_count < 3) ||
+        (cfg.base_addr % cfg.sector_size != 0) ||
+        ((uint64_t)cfg.base_addr + (uint64_t)cfg.sector_size * cfg.sector_count > 0x1000000))
+    {
+        return -4;
+    }
+
+    hs_spi_kv_gc_stop(hs_spi_kv);
+
+    pthread_mutex_lock(&hs_spi_kv->mutex);
+    hs_spi_kv_release(hs_spi_kv);
+    hs_spi_kv->hs_spi = hs_spi;
+    hs_spi_kv->config = cfg;
+    hs_spi_kv->pages_per_sector = cfg.sector_size / cfg.page_size;
+    hs_spi_kv->read_chunk_len = max_transfer_len - 4;
+    hs_spi_kv->entry_capacity = 1;
+    while (hs_spi_kv->entry_capacity < cfg.max_keys * 2)
+    {
+        hs_spi_kv->entry_capacity <<= 1;
+    }
+
+    hs_spi_kv->sectors = (hs_spi_kv_sector_t *)calloc(cfg.sector_count, sizeof(hs_spi_kv_sector_t));
+    hs_spi_kv->entries = (hs_spi_kv_entry_t *)calloc(hs_spi_kv->entry_capacity, sizeof(hs_spi_kv_entry_t));
+    hs_spi_kv->page_buf = (uint8_t *)malloc(cfg.page_size + 4);
+    hs_spi_kv->record_buf = (uint8_t *)malloc(cfg.page_size);
+    hs_spi_kv->sector_buf = (uint8_t *)malloc(cfg.sector_size);
+    if ((hs_spi_kv->sectors == NULL) || (hs_spi_kv->entries == NULL) || (hs_spi_kv->page_buf == NULL) ||
+        (hs_spi_kv->record_buf == NULL) || (hs_spi_kv->sector_buf == NULL))
+    {
+        hs_spi_kv_release(hs_spi_kv);
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -5;
+    }
+
+    if (hs_spi_kv_scan(hs_spi_kv) < 0)
+    {
+        hs_spi_kv_release(hs_spi_kv);
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -6;
+    }
+
+    hs_spi_kv->mounted = true;
+    hs_spi_kv->gc_stalled = false;
+    if (cfg.gc_free_sectors > 0)
+    {
+        if (pthread_create(&hs_spi_kv->gc_thread, NULL, hs_spi_kv_gc_thread, hs_spi_kv) != 0)
+        {
+            hs_spi_kv_release(hs_spi_kv);
+            pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+            return -7;
+        }
+
+        hs_spi_kv->gc_running = true;
+    }
+    pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+    return 0;
+}
+
+int hs_spi_kv_destroy(hs_spi_kv_t *hs_spi_kv)
+{
+    if (hs_spi_kv == NULL)
+    {
+        return -1;
+    }
+
+    hs_spi_kv_gc_stop(hs_spi_kv);
+
+    pthread_mutex_lock(&hs_spi_kv->mutex);
+    hs_spi_kv_release(hs_spi_kv);
+    pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+    pthread_cond_destroy(&hs_spi_kv->cond);
+    pthread_mutex_destroy(&hs_spi_kv->flash_mutex);
+    pthread_mutex_destroy(&hs_spi_kv->mutex);
+    free(hs_spi_kv);
+
+    return 0;
+}
+
+int hs_spi_kv_set(hs_spi_kv_t *hs_spi_kv, const char *key, const uint8_t *value, const size_t value_len)
+{
+    if (hs_spi_kv == NULL)
+    {
+        return -1;
+    }
+
+    if ((key == NULL) || (key[0] == '\0'))
+    {
+        return -2;
+    }
+
+    if ((value == NULL) && (value_len > 0))
+    {
+        return -3;
+    }
+
+    size_t key_len = strnlen(key, HS_SPI_KV_MAX_KEY_LEN + 1);
+    if (key_len > HS_SPI_KV_MAX_KEY_LEN)
+    {
+        return -4;
+    }
+
+    pthread_mutex_lock(&hs_spi_kv->mutex);
+    if (!hs_spi_kv->mounted)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -5;
+    }
+
+    if (HS_SPI_KV_RECORD_HEADER_LEN + key_len + value_len > hs_spi_kv->config.page_size)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -6;
+    }
+
+    int ret = hs_spi_kv_write_locked(hs_spi_kv, key, key_len, 0, value, value_len);
+    pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+    if (ret == -2)
+    {
+        return -7;
+    }
+
+    if (ret == -3)
+    {
+        return -8;
+    }
+
+    return ret < 0 ? -9 : 0;
+}
+
+int hs_spi_kv_get(hs_spi_kv_t *hs_spi_kv, const char *key, uint8_t *value, const size_t value_size,
+                  size_t *value_len)
+{
+    if (hs_spi_kv == NULL)
+    {
+        return -1;
+    }
+
+    if ((key == NULL) || (key[0] == '\0'))
+    {
+        return -2;
+    }
+
+    if ((value == NULL) && (value_size > 0))
+    {
+        return -3;
+    }
+
+    size_t key_len = strnlen(key, HS_SPI_KV_MAX_KEY_LEN + 1);
+
+    pthread_mutex_lock(&hs_spi_kv->mutex);
+    if (!hs_spi_kv->mounted)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -5;
+    }
+
+    hs_spi_kv_entry_t *entry = NULL;
+    if (key_len <= HS_SPI_KV_MAX_KEY_LEN)
+    {
+        entry = hs_spi_kv_index_find(hs_spi_kv, key, key_len, hs_spi_kv_hash(key, key_len));
+    }
+
+    if ((entry == NULL) || entry->deleted)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -4;
+    }
+
+    hs_spi_kv_record_t record = {0};
+    if ((hs_spi_kv_flash_read(hs_spi_kv, entry->addr, hs_spi_kv->record_buf, hs_spi_kv->config.page_size) < 0) ||
+        (hs_spi_kv_record_parse(hs_spi_kv, hs_spi_kv->record_buf, &record) < 0))
+    {
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -6;
+    }
+
+    if (record.value_len > value_size)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -7;
+    }
+
+    if (record.value_len > 0)
+    {
+        memcpy(value, record.value, record.value_len);
+    }
+
+    if (value_len != NULL)
+    {
+        *value_len = record.value_len;
+    }
+    pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+    return 0;
+}
+
+int hs_spi_kv_delete(hs_spi_kv_t *hs_spi_kv, const char *key)
+{
+    if (hs_spi_kv == NULL)
+    {
+        return -1;
+    }
+
+    if ((key == NULL) || (key[0] == '\0'))
+    {
+        return -2;
+    }
+
+    size_t key_len = strnlen(key, HS_SPI_KV_MAX_KEY_LEN + 1);
+    if (key_len > HS_SPI_KV_MAX_KEY_LEN)
+    {
+        return -2;
+    }
+
+    pthread_mutex_lock(&hs_spi_kv->mutex);
+    if (!hs_spi_kv->mounted)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -3;
+    }
+
+    int ret = hs_spi_kv_write_locked(hs_spi_kv, key, key_len, HS_SPI_KV_RECORD_FLAG_DELETED, NULL, 0);
+    pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+    if (ret == -1)
+    {
+        return -4;
+    }
+
+    if (ret == -3)
+    {
+        return -5;
+    }
+
+    return ret < 0 ? -6 : 0;
+}
+
+int hs_spi_kv_compact(hs_spi_kv_t *hs_spi_kv)
+{
+    if (hs_spi_kv == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&hs_spi_kv->mutex);
+    if (!hs_spi_kv->mounted)
+    {
+        pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+        return -2;
+    }
+
+    uint32_t reclaimed = 0;
+    int ret = hs_spi_kv_compact_locked(hs_spi_kv, &reclaimed);
+    pthread_mutex_unlock(&hs_spi_kv->mutex);
+
+    if (ret == -1)
+    {
+        return -3;
+    }
+
+    return ret < 0 ? -4 : 0;
+}
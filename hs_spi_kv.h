@@ -0,0 +1,144 @@
+/**
+ * @file      hs_spi_kv.h
+ * @brief     SPI NOR Flash 日志结构键值存储模块头文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 10:12:36
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#ifndef __HS_SPI_KV_H
+#define __HS_SPI_KV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hs_spi.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 键的最大长度（不含结束符）
+#define HS_SPI_KV_MAX_KEY_LEN 32
+
+// 键值存储配置
+typedef struct hs_spi_kv_config
+{
+    uint32_t base_addr;       // 存储区起始地址（需按扇区对齐，使用 3 字节地址，存储区需位于前 16MB）
+    uint32_t sector_size;     // 扇区大小（单位：字节），为 0 使用默认值 4096
+    uint32_t sector_count;    // 扇区数量（至少 3 个，其中 1 个保留用于整理）
+    uint32_t page_size;       // 页大小（单位：字节），为 0 使用默认值 256
+    size_t max_keys;          // 最大键数量，为 0 使用默认值 256
+    uint32_t gc_free_sectors; // 后台整理阈值：空闲扇区少于该值时后台线程开始整理，为 0 不启动后台整理
+} hs_spi_kv_config_t;
+
+// 键值存储对象
+typedef struct _hs_spi_kv hs_spi_kv_t;
+
+/**
+ * @brief 创建键值存储对象
+ *
+ * @return 成功: 键值存储对象
+ * @return 失败: NULL
+ */
+hs_spi_kv_t *hs_spi_kv_create(void);
+
+/**
+ * @brief 挂载键值存储
+ *
+ * @note 1. 挂载时顺序扫描存储区并在内存中重建哈希索引，空白或无法识别的存储区视为空存储
+ *       2. 每条记录占用一页，更新和删除只追加一条新记录（一次页编程），旧记录由整理回收
+ *       3. 记录带有 CRC 校验，掉电导致的不完整记录在挂载时被忽略，旧值仍然有效
+ *       4. 页大小加 4 字节（命令与地址）不能超过 SPI 单次最大传输长度（参考 hs_spi_set_max_transfer_len），
+ *          更长的读取按该长度分段，每段重新发送读命令
+ *       5. 该函数支持重复调用，重复调用时会先卸载再重新挂载
+ *       6. hs_spi 需已初始化，且在键值存储销毁前不能销毁
+ *
+ * @param[in,out] hs_spi_kv: 键值存储对象
+ * @param[in]     hs_spi   : SPI 对象
+ * @param[in]     config   : 键值存储配置
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_kv_mount(hs_spi_kv_t *hs_spi_kv, hs_spi_t *hs_spi, const hs_spi_kv_config_t *config);
+
+/**
+ * @brief 销毁键值存储对象
+ *
+ * @note 1. 调用该函数前必须确保没有其他线程正在使用该键值存储对象，否则可能导致未定义行为
+ *       2. 销毁后，该键值存储对象将不再可用，Flash 中的数据保持不变
+ *
+ * @param[in,out] hs_spi_kv: 键值存储对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_kv_destroy(hs_spi_kv_t *hs_spi_kv);
+
+/**
+ * @brief 写入键值
+ *
+ * @note 键长度与值长度之和不能超过 页大小 - 16 字节
+ *
+ * @param[in,out] hs_spi_kv: 键值存储对象
+ * @param[in]     key      : 键（以 '\0' 结尾的字符串）
+ * @param[in]     value    : 值
+ * @param[in]     value_len: 值长度（可以为 0）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_kv_set(hs_spi_kv_t *hs_spi_kv, const char *key, const uint8_t *value, const size_t value_len);
+
+/**
+ * @brief 读取键值
+ *
+ * @param[in,out] hs_spi_kv : 键值存储对象
+ * @param[in]     key       : 键（以 '\0' 结尾的字符串）
+ * @param[out]    value     : 读取到的值
+ * @param[in]     value_size: value 缓冲区大小
+ * @param[out]    value_len : 值的实际长度（可以为 NULL）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败（-4: 键不存在）
+ */
+int hs_spi_kv_get(hs_spi_kv_t *hs_spi_kv, const char *key, uint8_t *value, const size_t value_size,
+                  size_t *value_len);
+
+/**
+ * @brief 删除键值
+ *
+ * @note 删除通过追加删除标记实现，标记随所在扇区整理时一并回收
+ *
+ * @param[in,out] hs_spi_kv: 键值存储对象
+ * @param[in]     key      : 键（以 '\0' 结尾的字符串）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败（-4: 键不存在）
+ */
+int hs_spi_kv_delete(hs_spi_kv_t *hs_spi_kv, const char *key);
+
+/**
+ * @brief 整理一个扇区
+ *
+ * @note 1. 将最旧扇区中的有效记录搬移到当前写入扇区后擦除该扇区，扇区按环形顺序轮换使用
+ *       2. 空间不足时写入接口会自动调用整理，也可以在空闲时主动调用以减少写入延迟
+ *       3. 最旧扇区中的有效记录未能全部搬移（如读取校验失败）时不擦除该扇区并返回失败，不会丢失有效记录
+ *
+ * @param[in,out] hs_spi_kv: 键值存储对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败（-3: 没有可整理的扇区）
+ */
+int hs_spi_kv_compact(hs_spi_kv_t *hs_spi_kv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HS_SPI_KV_H
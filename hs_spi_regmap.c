@@ -0,0 +1,664 @@
+/**
+ * @file      hs_spi_regmap.c
+ * @brief     SPI 寄存器映射访问模块源文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 18:40:33
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "hs_spi_regmap.h"
+
+// 寄存器映射对象
+struct _hs_spi_regmap
+{
+    hs_spi_t *hs_spi;
+    const hs_spi_regmap_desc_t *desc;
+    size_t max_message_len;
+    size_t xfer_cap; // 单条消息最大传输段数
+
+    uint32_t *cache;   // 非易失寄存器缓存值
+    bool *cache_valid; // 缓存是否有效
+
+    uint8_t *tx_buf;
+    uint8_t *rx_buf;
+    hs_spi_xfer_t *xfers;
+    pthread_mutex_t mutex;
+};
+
+static uint32_t hs_spi_regmap_mask(const uint8_t width)
+{
+    return width >= 4 ? 0xFFFFFFFF : ((1u << (8 * width)) - 1);
+}
+
+static void hs_spi_regmap_encode(const hs_spi_regmap_t *hs_spi_regmap, uint8_t *buf, const uint8_t width,
+                                 const uint32_t value)
+{
+    for (uint8_t i = 0; i < width; i++)
+    {
+        uint8_t shift = hs_spi_regmap->desc->little_endian ? i : (width - 1 - i);
+        buf[i] = (uint8_t)(value >> (8 * shift));
+    }
+}
+
+static uint32_t hs_spi_regmap_decode(const hs_spi_regmap_t *hs_spi_regmap, const uint8_t *buf, const uint8_t width)
+{
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < width; i++)
+    {
+        uint8_t shift = hs_spi_regmap->desc->little_endian ? i : (width - 1 - i);
+        value |= (uint32_t)buf[i] << (8 * shift);
+    }
+
+    return value;
+}
+
+/**
+ * @brief 计算帧首字节
+ *
+ * @param[in] hs_spi_regmap: 寄存器映射对象
+ * @param[in] addr         : 起始寄存器地址
+ * @param[in] flag         : 读或写标志
+ * @param[in] data_len     : 帧数据长度
+ *
+ * @return 帧首字节
+ */
+static uint8_t hs_spi_regmap_header(const hs_spi_regmap_t *hs_spi_regmap, const uint8_t addr, const uint8_t flag,
+                                    const size_t data_len)
+{
+    return addr | flag | (data_len > 1 ? hs_spi_regmap->desc->burst_flag : 0);
+}
+
+static bool hs_spi_regmap_cacheable(const hs_spi_regmap_t *hs_spi_regmap, const size_t reg)
+{
+    return (hs_spi_regmap->desc->regs[reg].flags & HS_SPI_REGMAP_FLAG_VOLATILE) == 0;
+}
+
+/**
+ * @brief 两个寄存器能否合并为一次突发访问
+ *
+ * @param[in] hs_spi_regmap: 寄存器映射对象
+ * @param[in] prev         : 前一个寄存器序号
+ * @param[in] next         : 后一个寄存器序号
+ *
+ * @return true : 可以合并
+ * @return false: 不能合并
+ */
+static bool hs_spi_regmap_contiguous(const hs_spi_regmap_t *hs_spi_regmap, const size_t prev, const size_t next)
+{
+    const hs_spi_regmap_reg_t *a = &hs_spi_regmap->desc->regs[prev];
+    const hs_spi_regmap_reg_t *b = &hs_spi_regmap->desc->regs[next];
+
+    return (a->burst_group != 0) && (a->burst_group == b->burst_group) && ((unsigned)a->addr + a->width == b->addr);
+}
+
+/**
+ * @brief 从总线读取单个寄存器
+ *
+ * @note 调用前需持有互斥锁
+ *
+ * @param[in]  hs_spi_regmap: 寄存器映射对象
+ * @param[in]  reg          : 寄存器序号
+ * @param[out] value        : 读取到的值
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_regmap_read_locked(hs_spi_regmap_t *hs_spi_regmap, const size_t reg, uint32_t *value)
+{
+    const hs_spi_regmap_reg_t *desc_reg = &hs_spi_regmap->desc->regs[reg];
+    if (hs_spi_regmap_cacheable(hs_spi_regmap, reg) && hs_spi_regmap->cache_valid[reg])
+    {
+        *value = hs_spi_regmap->cache[reg];
+
+        return 0;
+    }
+
+    uint8_t data[4] = {0};
+    uint8_t header = hs_spi_regmap_header(hs_spi_regmap, desc_reg->addr, hs_spi_regmap->desc->read_flag,
+                                          desc_reg->width);
+    if (hs_spi_read_data_sub(hs_spi_regmap->hs_spi, header, data, desc_reg->width) < 0)
+    {
+        return -1;
+    }
+
+    *value = hs_spi_regmap_decode(hs_spi_regmap, data, desc_reg->width);
+    if (hs_spi_regmap_cacheable(hs_spi_regmap, reg))
+    {
+        hs_spi_regmap->cache[reg] = *value;
+        hs_spi_regmap->cache_valid[reg] = true;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 向总线写入单个寄存器
+ *
+ * @note 调用前需持有互斥锁
+ *
+ * @param[in] hs_spi_regmap: 寄存器映射对象
+ * @param[in] reg          : 寄存器序号
+ * @param[in] value        : 写入值
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+static int hs_spi_regmap_write_locked(hs_spi_regmap_t *hs_spi_regmap, const size_t reg, const uint32_t value)
+{
+    const hs_spi_regmap_reg_t *desc_reg = &hs_spi_regmap->desc->regs[reg];
+
+    uint8_t data[4] = {0};
+    hs_spi_regmap_encode(hs_spi_regmap, data, desc_reg->width, value);
+    uint8_t header = hs_spi_regmap_header(hs_spi_regmap, desc_reg->addr, hs_spi_regmap->desc->write_flag,
+                                          desc_reg->width);
+    if (hs_spi_write_data_sub(hs_spi_regmap->hs_spi, header, data, desc_reg->width) < 0)
+    {
+        hs_spi_regmap->cache_valid[reg] = false;
+
+        return -1;
+    }
+
+    if (hs_spi_regmap_cacheable(hs_spi_regmap, reg))
+    {
+        hs_spi_regmap->cache[reg] = value;
+        hs_spi_regmap->cache_valid[reg] = true;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 释放初始化时申请的资源
+ *
+ * @param[in] hs_spi_regmap: 寄存器映射对象
+ */
+static void hs_spi_regmap_release(hs_spi_regmap_t *hs_spi_regmap)
+{
+    free(hs_spi_regmap->cache);
+    free(hs_spi_regmap->cache_valid);
+    free(hs_spi_regmap->tx_buf);
+    free(hs_spi_regmap->rx_buf);
+    free(hs_spi_regmap->xfers);
+    hs_spi_regmap->cache = NULL;
+    hs_spi_regmap->cache_valid = NULL;
+    hs_spi_regmap->tx_buf = NULL;
+    hs_spi_regmap->rx_buf = NULL;
+    hs_spi_regmap->xfers = NULL;
+    hs_spi_regmap->desc = NULL;
+}
+
+hs_spi_regmap_t *hs_spi_regmap_create(void)
+{
+    hs_spi_regmap_t *hs_spi_regmap = (hs_spi_regmap_t *)malloc(sizeof(hs_spi_regmap_t));
+    if (hs_spi_regmap == NULL)
+    {
+        return NULL;
+    }
+
+    memset(hs_spi_regmap, 0, sizeof(hs_spi_regmap_t));
+    pthread_mutex_init(&hs_spi_regmap->mutex, NULL);
+
+    return hs_spi_regmap;
+}
+
+int hs_spi_regmap_init(hs_spi_regmap_t *hs_spi_regmap, hs_spi_t *hs_spi, const hs_spi_regmap_desc_t *desc)
+{
+    if (hs_spi_regmap == NULL)
+    {
+        return -1;
+    }
+
+    if (hs_spi == NULL)
+    {
+        return -2;
+    }
+
+    if ((desc == NULL) || (desc->regs == NULL) || (desc->reg_count == 0))
+    {
+        return -3;
+    }
+
+    for (size_t i = 0; i < desc->reg_count; i++)
+    {
+        uint8_t width = desc->regs[i].width;
+        if ((width != 1) && (width != 2) && (width != 4))
+        {
+            return -4;
+        }
+    }
+
+    size_t max_transfer_len = 0;
+    if (hs_spi_get_max_transfer_len(hs_spi, &max_transfer_len) < 0)
+    {
+        return -2;
+    }
+
+    size_t max_message_len = desc->max_message_len;
+    if (max_message_len == 0)
+    {
+        max_message_len = max_transfer_len < 4096 ? max_transfer_len : 4096;
+    }
+    // 至少能容纳一个最宽寄存器的完整帧，且一条消息在一次传输中发送
+    if ((max_message_len < 5) || (max_message_len > max_transfer_len))
+    {
+        return -4;
+    }
+
+    pthread_mutex_lock(&hs_spi_regmap->mutex);
+    hs_spi_regmap_release(hs_spi_regmap);
+    hs_spi_regmap->hs_spi = hs_spi;
+    hs_spi_regmap->desc = desc;
+    hs_spi_regmap->max_message_len = max_message_len;
+    // 最短的帧为 1 字节地址 + 1 字节数据，读帧拆为两个传输段
+    hs_spi_regmap->xfer_cap = max_message_len < HS_SPI_MAX_XFER_COUNT ? max_message_len : HS_SPI_MAX_XFER_COUNT;
+    hs_spi_regmap->cache = (uint32_t *)calloc(desc->reg_count, sizeof(uint32_t));
+    hs_spi_regmap->cache_valid = (bool *)calloc(desc->reg_count, sizeof(bool));
+    hs_spi_regmap->tx_buf = (uint8_t *)malloc(max_message_len);
+    hs_spi_regmap->rx_buf = (uint8_t *)malloc(max_message_len);
+    hs_spi_regmap->xfers = (hs_spi_xfer_t *)calloc(hs_spi_regmap->xfer_cap, sizeof(hs_spi_xfer_t));
+    if ((hs_spi_regmap->cache == NULL) || (hs_spi_regmap->cache_valid == NULL) || (hs_spi_regmap->tx_buf == NULL) ||
+        (hs_spi_regmap->rx_buf == NULL) || (hs_spi_regmap->xfers == NULL))
+    {
+        hs_spi_regmap_release(hs_spi_regmap);
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -5;
+    }
+    pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+    return 0;
+}
+
+int hs_spi_regmap_destroy(hs_spi_regmap_t *hs_spi_regmap)
+{
+    if (hs_spi_regmap == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&hs_spi_regmap->mutex);
+    hs_spi_regmap_release(hs_spi_regmap);
+    pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+    pthread_mutex_destroy(&hs_spi_regmap->mutex);
+    free(hs_spi_regmap);
+
+    return 0;
+}
+
+int hs_spi_regmap_read(hs_spi_regmap_t *hs_spi_regmap, const size_t reg, uint32_t *value)
+{
+    if (hs_spi_regmap == NULL)
+    {
+        return -1;
+    }
+
+    if (value == NULL)
+    {
+        return -2;
+    }
+
+    pthread_mutex_lock(&hs_spi_regmap->mutex);
+    if (hs_spi_regmap->desc == NULL)
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -3;
+    }
+
+    if ((reg >= hs_spi_regmap->desc->reg_count) ||
+        ((hs_spi_regmap->desc->regs[reg].flags & HS_SPI_REGMAP_FLAG_READ) == 0))
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -4;
+    }
+
+    int ret = hs_spi_regmap_read_locked(hs_spi_regmap, reg, value);
+    pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+    return ret < 0 ? -5 : 0;
+}
+
+int hs_spi_regmap_write(hs_spi_regmap_t *hs_spi_regmap, const size_t reg, const uint32_t value)
+{
+    if (hs_spi_regmap == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&hs_spi_regmap->mutex);
+    if (hs_spi_regmap->desc == NULL)
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -2;
+    }
+
+    if ((reg >= hs_spi_regmap->desc->reg_count) ||
+        ((hs_spi_regmap->desc->regs[reg].flags & HS_SPI_REGMAP_FLAG_WRITE) == 0))
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -3;
+    }
+
+    uint32_t masked = value & hs_spi_regmap_mask(hs_spi_regmap->desc->regs[reg].width);
+    int ret = hs_spi_regmap_write_locked(hs_spi_regmap, reg, masked);
+    pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+    return ret < 0 ? -4 : 0;
+}
+
+int hs_spi_regmap_update_bits(hs_spi_regmap_t *hs_spi_regmap, const size_t reg, const uint32_t mask,
+                              const uint32_t value)
+{
+    if (hs_spi_regmap == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&hs_spi_regmap->mutex);
+    if (hs_spi_regmap->desc == NULL)
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -2;
+    }
+
+    uint8_t rw = HS_SPI_REGMAP_FLAG_READ | HS_SPI_REGMAP_FLAG_WRITE;
+    if ((reg >= hs_spi_regmap->desc->reg_count) || ((hs_spi_regmap->desc->regs[reg].flags & rw) != rw))
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -3;
+    }
+
+    uint32_t old_value = 0;
+    if (hs_spi_regmap_read_locked(hs_spi_regmap, reg, &old_value) < 0)
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -4;
+    }
+
+    uint32_t new_value = ((old_value & ~mask) | (value & mask)) & hs_spi_regmap_mask(hs_spi_regmap->desc->regs[reg].width);
+    if ((new_value == old_value) && hs_spi_regmap_cacheable(hs_spi_regmap, reg))
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return 0;
+    }
+
+    int ret = hs_spi_regmap_write_locked(hs_spi_regmap, reg, new_value);
+    pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+    return ret < 0 ? -5 : 0;
+}
+
+int hs_spi_regmap_write_list(hs_spi_regmap_t *hs_spi_regmap, const hs_spi_regmap_write_t *list, const size_t count)
+{
+    if (hs_spi_regmap == NULL)
+    {
+        return -1;
+    }
+
+    if (list == NULL)
+    {
+        return -2;
+    }
+
+    if (count == 0)
+    {
+        return -3;
+    }
+
+    pthread_mutex_lock(&hs_spi_regmap->mutex);
+    const hs_spi_regmap_desc_t *desc = hs_spi_regmap->desc;
+    if (desc == NULL)
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -4;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((list[i].reg >= desc->reg_count) || ((desc->regs[list[i].reg].flags & HS_SPI_REGMAP_FLAG_WRITE) == 0))
+        {
+            pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+            return -5;
+        }
+    }
+
+    size_t tx_len = 0;
+    size_t xfer_count = 0;
+    size_t msg_start = 0; // 当前消息包含的第一个写入项
+    size_t last_reg = 0;  // 当前帧的最后一个寄存器
+    for (size_t i = 0; i <= count; i++)
+    {
+        const hs_spi_regmap_reg_t *reg = i < count ? &desc->regs[list[i].reg] : NULL;
+        uint32_t value = i < count ? list[i].value & hs_spi_regmap_mask(reg->width) : 0;
+
+        // 值未变化的非易失寄存器无需写入（缓存在写入项加入消息时即更新，同一列表中重复的寄存器与待写入值比较）
+        bool cacheable = (reg != NULL) && hs_spi_regmap_cacheable(hs_spi_regmap, list[i].reg);
+        if (cacheable && hs_spi_regmap->cache_valid[list[i].reg] && (hs_spi_regmap->cache[list[i].reg] == value))
+        {
+            continue;
+        }
+
+        // 追加到当前帧
+        size_t room = hs_spi_regmap->max_message_len - tx_len;
+        if ((reg != NULL) && (xfer_count > 0) && hs_spi_regmap_contiguous(hs_spi_regmap, last_reg, list[i].reg) &&
+            (room >= reg->width))
+        {
+            hs_spi_xfer_t *xfer = &hs_spi_regmap->xfers[xfer_count - 1];
+            uint8_t *frame = (uint8_t *)xfer->tx_buf;
+            frame[0] |= desc->burst_flag;
+            hs_spi_regmap_encode(hs_spi_regmap, &hs_spi_regmap->tx_buf[tx_len], reg->width, value);
+            tx_len += reg->width;
+            xfer->len += reg->width;
+            last_reg = list[i].reg;
+            if (cacheable)
+            {
+                hs_spi_regmap->cache[list[i].reg] = value;
+                hs_spi_regmap->cache_valid[list[i].reg] = true;
+            }
+
+            continue;
+        }
+
+        // 列表结束或放不下新帧时发送当前消息
+        if ((reg == NULL) || (xfer_count >= hs_spi_regmap->xfer_cap) || (room < 1 + (size_t)reg->width))
+        {
+            int ret = xfer_count > 0 ? hs_spi_transfer(hs_spi_regmap->hs_spi, hs_spi_regmap->xfers, xfer_count) : 0;
+            if (ret < 0)
+            {
+                // 无法确定哪些寄存器已写入，使当前消息涉及的寄存器缓存失效
+                for (size_t k = msg_start; k < i; k++)
+                {
+                    hs_spi_regmap->cache_valid[list[k].reg] = false;
+                }
+                pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+                return -6;
+            }
+
+            tx_len = 0;
+            xfer_count = 0;
+            msg_start = i;
+            if (reg == NULL)
+            {
+                break;
+            }
+        }
+
+        hs_spi_xfer_t *xfer = &hs_spi_regmap->xfers[xfer_count++];
+        xfer->tx_buf = &hs_spi_regmap->tx_buf[tx_len];
+        xfer->rx_buf = NULL;
+        xfer->len = 1 + reg->width;
+        xfer->cs_change = true;
+        hs_spi_regmap->tx_buf[tx_len] = hs_spi_regmap_header(hs_spi_regmap, reg->addr, desc->write_flag, reg->width);
+        hs_spi_regmap_encode(hs_spi_regmap, &hs_spi_regmap->tx_buf[tx_len + 1], reg->width, value);
+        tx_len += xfer->len;
+        last_reg = list[i].reg;
+        if (cacheable)
+        {
+            hs_spi_regmap->cache[list[i].reg] = value;
+            hs_spi_regmap->cache_valid[list[i].reg] = true;
+        }
+    }
+    pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+    return 0;
+}
+
+int hs_spi_regmap_read_range(hs_spi_regmap_t *hs_spi_regmap, const size_t first_reg, const size_t reg_count,
+                             uint32_t *values)
+{
+    if (hs_spi_regmap == NULL)
+    {
+        return -1;
+    }
+
+    if (values == NULL)
+    {
+        return -2;
+    }
+
+    if (reg_count == 0)
+    {
+        return -3;
+    }
+
+    pthread_mutex_lock(&hs_spi_regmap->mutex);
+    const hs_spi_regmap_desc_t *desc = hs_spi_regmap->desc;
+    if (desc == NULL)
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -4;
+    }
+
+    if ((first_reg >= desc->reg_count) || (reg_count > desc->reg_count - first_reg))
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -5;
+    }
+
+    for (size_t i = first_reg; i < first_reg + reg_count; i++)
+    {
+        if ((desc->regs[i].flags & HS_SPI_REGMAP_FLAG_READ) == 0)
+        {
+            pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+            return -5;
+        }
+    }
+
+    // 每帧占用 2 个传输段: 地址字节依次存放在发送缓冲区，数据依次存放在接收缓冲区
+    size_t frame_count = 0;
+    size_t xfer_count = 0;
+    size_t rx_len = 0;
+    size_t msg_start = first_reg; // 当前消息包含的第一个寄存器
+    size_t end_reg = first_reg + reg_count;
+    for (size_t i = first_reg; i <= end_reg; i++)
+    {
+        const hs_spi_regmap_reg_t *reg = i < end_reg ? &desc->regs[i] : NULL;
+        size_t room = hs_spi_regmap->max_message_len - (frame_count + rx_len);
+
+        // 追加到当前帧
+        if ((reg != NULL) && (frame_count > 0) && hs_spi_regmap_contiguous(hs_spi_regmap, i - 1, i) &&
+            (room >= reg->width))
+        {
+            hs_spi_regmap->tx_buf[frame_count - 1] |= desc->burst_flag;
+            hs_spi_regmap->xfers[xfer_count - 1].len += reg->width;
+            rx_len += reg->width;
+
+            continue;
+        }
+
+        // 区间结束或放不下新帧时发送当前消息并解析
+        if ((reg == NULL) || (xfer_count + 2 > hs_spi_regmap->xfer_cap) || (room < 1 + (size_t)reg->width))
+        {
+            if (hs_spi_transfer(hs_spi_regmap->hs_spi, hs_spi_regmap->xfers, xfer_count) < 0)
+            {
+                pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+                return -6;
+            }
+
+            size_t rx_offset = 0;
+            for (size_t k = msg_start; k < i; k++)
+            {
+                values[k - first_reg] = hs_spi_regmap_decode(hs_spi_regmap, &hs_spi_regmap->rx_buf[rx_offset],
+                                                             desc->regs[k].width);
+                rx_offset += desc->regs[k].width;
+                if (hs_spi_regmap_cacheable(hs_spi_regmap, k))
+                {
+                    hs_spi_regmap->cache[k] = values[k - first_reg];
+                    hs_spi_regmap->cache_valid[k] = true;
+                }
+            }
+
+            frame_count = 0;
+            xfer_count = 0;
+            rx_len = 0;
+            msg_start = i;
+            if (reg == NULL)
+            {
+                break;
+            }
+        }
+
+        hs_spi_regmap->tx_buf[frame_count] = hs_spi_regmap_header(hs_spi_regmap, reg->addr, desc->read_flag,
+                                                                  reg->width);
+
+        hs_spi_xfer_t *xfer = &hs_spi_regmap->xfers[xfer_count++];
+        xfer->tx_buf = &hs_spi_regmap->tx_buf[frame_count];
+        xfer->rx_buf = NULL;
+        xfer->len = 1;
+        xfer->cs_change = false;
+
+        xfer = &hs_spi_regmap->xfers[xfer_count++];
+        xfer->tx_buf = NULL;
+        xfer->rx_buf = &hs_spi_regmap->rx_buf[rx_len];
+        xfer->len = reg->width;
+        xfer->cs_change = true;
+
+        frame_count++;
+        rx_len += reg->width;
+    }
+    pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+    return 0;
+}
+
+int hs_spi_regmap_invalidate(hs_spi_regmap_t *hs_spi_regmap)
+{
+    if (hs_spi_regmap == NULL)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&hs_spi_regmap->mutex);
+    if (hs_spi_regmap->desc == NULL)
+    {
+        pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+        return -2;
+    }
+
+    memset(hs_spi_regmap->cache_valid, 0, hs_spi_regmap->desc->reg_count * sizeof(bool));
+    pthread_mutex_unlock(&hs_spi_regmap->mutex);
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file      hs_spi_regmap.h
+ * @brief     SPI 寄存器映射访问模块头文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 18:40:27
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#ifndef __HS_SPI_REGMAP_H
+#define __HS_SPI_REGMAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hs_spi.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 寄存器属性
+#define HS_SPI_REGMAP_FLAG_READ     0x01 // 可读
+#define HS_SPI_REGMAP_FLAG_WRITE    0x02 // 可写
+#define HS_SPI_REGMAP_FLAG_VOLATILE 0x04 // 易失（值可能被设备修改，不缓存）
+
+// 寄存器描述
+typedef struct hs_spi_regmap_reg
+{
+    uint8_t addr;        // 寄存器地址
+    uint8_t width;       // 寄存器宽度（1/2/4 字节）
+    uint8_t flags;       // 寄存器属性
+    uint8_t burst_group; // 突发访问组（非 0 且相同的地址连续寄存器可合并为一次突发访问）
+} hs_spi_regmap_reg_t;
+
+// 设备描述，通常由 tools/hs_spi_regmap_gen.py 根据寄存器描述文件生成
+typedef struct hs_spi_regmap_desc
+{
+    const hs_spi_regmap_reg_t *regs; // 寄存器表
+    size_t reg_count;                // 寄存器数量
+    uint8_t read_flag;               // 读操作时与地址按位或的标志（如 0x80）
+    uint8_t write_flag;              // 写操作时与地址按位或的标志
+    uint8_t burst_flag;              // 多寄存器突发访问时与地址按位或的标志（如 0x40），设备默认自增时为 0
+    bool little_endian;              // 多字节寄存器是否小端传输（默认大端）
+    size_t max_message_len;          // 单条消息最大长度（不能超过 SPI 单次最大传输长度），为 0 使用 4096 与该长度中的较小值
+} hs_spi_regmap_desc_t;
+
+// 寄存器写入项
+typedef struct hs_spi_regmap_write
+{
+    size_t reg;     // 寄存器序号（寄存器表下标）
+    uint32_t value; // 写入值
+} hs_spi_regmap_write_t;
+
+// 寄存器映射对象
+typedef struct _hs_spi_regmap hs_spi_regmap_t;
+
+/**
+ * @brief 创建寄存器映射对象
+ *
+ * @return 成功: 寄存器映射对象
+ * @return 失败: NULL
+ */
+hs_spi_regmap_t *hs_spi_regmap_create(void);
+
+/**
+ * @brief 初始化寄存器映射对象
+ *
+ * @note 1. 该函数支持重复调用，重复调用时会清空寄存器缓存
+ *       2. hs_spi 需已初始化，desc 及其寄存器表需在寄存器映射对象销毁前保持有效
+ *       3. desc->max_message_len 超过 SPI 单次最大传输长度（参考 hs_spi_set_max_transfer_len）时初始化失败
+ *
+ * @param[in,out] hs_spi_regmap: 寄存器映射对象
+ * @param[in]     hs_spi       : SPI 对象
+ * @param[in]     desc         : 设备描述
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_regmap_init(hs_spi_regmap_t *hs_spi_regmap, hs_spi_t *hs_spi, const hs_spi_regmap_desc_t *desc);
+
+/**
+ * @brief 销毁寄存器映射对象
+ *
+ * @note 1. 调用该函数前必须确保没有其他线程正在使用该寄存器映射对象，否则可能导致未定义行为
+ *       2. 销毁后，该寄存器映射对象将不再可用
+ *
+ * @param[in,out] hs_spi_regmap: 寄存器映射对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_regmap_destroy(hs_spi_regmap_t *hs_spi_regmap);
+
+/**
+ * @brief 读寄存器
+ *
+ * @note 非易失寄存器在缓存有效时直接返回缓存值，不访问总线
+ *
+ * @param[in,out] hs_spi_regmap: 寄存器映射对象
+ * @param[in]     reg          : 寄存器序号
+ * @param[out]    value        : 读取到的值
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_regmap_read(hs_spi_regmap_t *hs_spi_regmap, const size_t reg, uint32_t *value);
+
+/**
+ * @brief 写寄存器
+ *
+ * @param[in,out] hs_spi_regmap: 寄存器映射对象
+ * @param[in]     reg          : 寄存器序号
+ * @param[in]     value        : 写入值
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_regmap_write(hs_spi_regmap_t *hs_spi_regmap, const size_t reg, const uint32_t value);
+
+/**
+ * @brief 修改寄存器的部分位
+ *
+ * @note 非易失寄存器缓存有效时不回读，且值未变化时不写入
+ *
+ * @param[in,out] hs_spi_regmap: 寄存器映射对象
+ * @param[in]     reg          : 寄存器序号
+ * @param[in]     mask         : 待修改的位
+ * @param[in]     value        : 新值（只取 mask 中的位）
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_regmap_update_bits(hs_spi_regmap_t *hs_spi_regmap, const size_t reg, const uint32_t mask,
+                              const uint32_t value);
+
+/**
+ * @brief 批量写寄存器
+ *
+ * @note 1. 按列表顺序写入，与缓存值（或列表中该寄存器前一次的写入值）相同的非易失寄存器被跳过
+ *       2. 列表中相邻、地址连续且属于同一突发访问组的寄存器合并为一帧，所有帧合并为尽量少的消息发送
+ *
+ * @param[in,out] hs_spi_regmap: 寄存器映射对象
+ * @param[in]     list         : 寄存器写入列表
+ * @param[in]     count        : 寄存器写入个数
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_regmap_write_list(hs_spi_regmap_t *hs_spi_regmap, const hs_spi_regmap_write_t *list, const size_t count);
+
+/**
+ * @brief 读取连续的多个寄存器
+ *
+ * @note 1. 属于同一突发访问组且地址连续的寄存器合并为一次突发读，结果同时更新非易失寄存器缓存
+ *       2. 总是访问总线，用于读取采样数据等易失寄存器
+ *
+ * @param[in,out] hs_spi_regmap: 寄存器映射对象
+ * @param[in]     first_reg    : 第一个寄存器序号
+ * @param[in]     reg_count    : 寄存器个数
+ * @param[out]    values       : 读取到的值
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_regmap_read_range(hs_spi_regmap_t *hs_spi_regmap, const size_t first_reg, const size_t reg_count,
+                             uint32_t *values);
+
+/**
+ * @brief 清空寄存器缓存
+ *
+ * @note 设备复位或掉电后需要调用
+ *
+ * @param[in,out] hs_spi_regmap: 寄存器映射对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_regmap_invalidate(hs_spi_regmap_t *hs_spi_regmap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HS_SPI_REGMAP_H
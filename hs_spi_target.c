@@ -0,0 +1,441 @@
+/**
+ * @file      hs_spi_target.c
+ * @brief     SPI 从机（目标）模式接收模块源文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 20:05:43
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <signal.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "hs_spi_target.h"
+
+// 从机接收对象
+struct _hs_spi_target
+{
+    hs_spi_t *hs_spi;
+    hs_spi_target_config_t config;
+
+    uint8_t *ring;  // 环形缓冲区（ring_size 帧）
+    size_t head;    // 下一个待读取的帧
+    size_t count;   // 待读取的帧数
+    uint8_t *spare; // 环形缓冲区已满时的临时接收缓冲区（一帧，内容丢弃）
+
+    hs_spi_xfer_t *xfers; // 预先挂起的接收传输段，由接收线程独占
+    hs_spi_target_stats_t stats;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond; // 有新帧或接收线程退出
+    pthread_t thread;
+    bool running;        // 接收线程已启动
+    bool stopping;       // 请求接收线程退出
+    bool exited;         // 接收线程已退出
+};
+
+/**
+ * @brief 接收线程
+ *
+ * @note 每轮将环形缓冲区中紧随已缓存帧之后的空闲帧挂到传输段上，不加锁提交整条消息，读取者只访问已缓存的帧，
+ *       与正在接收的帧互不重叠
+ *
+ * @param[in] arg: 从机接收对象
+ *
+ * @return NULL
+ */
+static void *hs_spi_target_thread(void *arg)
+{
+    hs_spi_target_t *hs_spi_target = (hs_spi_target_t *)arg;
+    const size_t frame_len = hs_spi_target->config.frame_len;
+    const size_t armed_count = hs_spi_target->config.armed_count;
+    const size_t ring_size = hs_spi_target->config.ring_size;
+    const hs_spi_target_transfer_cb transfer_cb = hs_spi_target->config.transfer_cb;
+    // 上一条消息完成的时刻，用于统计重新提交的间隙
+    struct timespec done_time = {0};
+    bool has_done = false;
+
+    pthread_mutex_lock(&hs_spi_target->mutex);
+    while (!hs_spi_target->stopping)
+    {
+        size_t free_count = ring_size - hs_spi_target->count;
+        size_t ring_count = free_count < armed_count ? free_count : armed_count;
+        size_t tail = (hs_spi_target->head + hs_spi_target->count) % ring_size;
+        for (size_t i = 0; i < armed_count; i++)
+        {
+            hs_spi_target->xfers[i].rx_buf = i < ring_count ? &hs_spi_target->ring[((tail + i) % ring_size) * frame_len]
+                                                            : hs_spi_target->spare;
+        }
+
+        if (has_done)
+        {
+            struct timespec now_time = {0};
+            clock_gettime(CLOCK_MONOTONIC, &now_time);
+            long rearm_us =
+                (now_time.tv_sec - done_time.tv_sec) * 1000000 + (now_time.tv_nsec - done_time.tv_nsec) / 1000;
+            if ((rearm_us > 0) && ((uint64_t)rearm_us > hs_spi_target->stats.max_rearm_us))
+            {
+                hs_spi_target->stats.max_rearm_us = (uint64_t)rearm_us;
+            }
+        }
+        pthread_mutex_unlock(&hs_spi_target->mutex);
+
+        int ret = transfer_cb(hs_spi_target->hs_spi, hs_spi_target->xfers, armed_count);
+        clock_gettime(CLOCK_MONOTONIC, &done_time);
+        has_done = ret >= 0;
+
+        pthread_mutex_lock(&hs_spi_target->mutex);
+        if (ret < 0)
+        {
+            hs_spi_target->stats.error_count++;
+            pthread_mutex_unlock(&hs_spi_target->mutex);
+
+            // 避免设备异常时空转
+            usleep(1000);
+            pthread_mutex_lock(&hs_spi_target->mutex);
+
+            continue;
+        }
+
+        hs_spi_target->count += ring_count;
+        hs_spi_target->stats.message_count++;
+        hs_spi_target->stats.received_frames += ring_count;
+        hs_spi_target->stats.dropped_frames += armed_count - ring_count;
+        if (ring_count > 0)
+        {
+            pthread_cond_broadcast(&hs_spi_target->cond);
+        }
+    }
+    hs_spi_target->exited = true;
+    pthread_cond_broadcast(&hs_spi_target->cond);
+    pthread_mutex_unlock(&hs_spi_target->mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief 获取 CLOCK_MONOTONIC 时钟下 timeout_ms 毫秒后的时刻
+ *
+ * @param[out] abstime   : 超时时刻
+ * @param[in]  timeout_ms: 超时时间（单位：毫秒）
+ */
+static void hs_spi_target_abstime(struct timespec *abstime, const long timeout_ms)
+{
+    clock_gettime(CLOCK_MONOTONIC, abstime);
+    abstime->tv_sec += timeout_ms / 1000;
+    abstime->tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (abstime->tv_nsec >= 1000000000L)
+    {
+        abstime->tv_sec++;
+        abstime->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief 停止接收线程
+ *
+ * @note 1. 调用前不能持有互斥锁
+ *       2. 设置了 abort_signal 时周期性发送信号，直到接收线程退出（信号可能在线程进入 ioctl() 前到达）
+ *
+ * @param[in] hs_spi_target: 从机接收对象
+ */
+static void hs_spi_target_stop(hs_spi_target_t *hs_spi_target)
+{
+    pthread_mutex_lock(&hs_spi_target->mutex);
+    if (!hs_spi_target->running)
+    {
+        pthread_mutex_unlock(&hs_spi_target->mutex);
+
+        return;
+    }
+
+    hs_spi_target->stopping = true;
+    while (!hs_spi_target->exited)
+    {
+        if (hs_spi_target->config.abort_signal == 0)
+        {
+            pthread_cond_wait(&hs_spi_target->cond, &hs_spi_target->mutex);
+
+            continue;
+        }
+
+        pthread_kill(hs_spi_target->thread, hs_spi_target->config.abort_signal);
+        struct timespec abstime;
+        hs_spi_target_abstime(&abstime, 10);
+        pthread_cond_timedwait(&hs_spi_target->cond, &hs_spi_target->mutex, &abstime);
+    }
+    hs_spi_target->running = false;
+    pthread_mutex_unlock(&hs_spi_target->mutex);
+
+    pthread_join(hs_spi_target->thread, NULL);
+}
+
+/**
+ * @brief 释放初始化时申请的资源
+ *
+ * @param[in] hs_spi_target: 从机接收对象
+ */
+static void hs_spi_target_release(hs_spi_target_t *hs_spi_target)
+{
+    free(hs_spi_target->ring);
+    free(hs_spi_target->spare);
+    free(hs_spi_target->xfers);
+    hs_spi_target->ring = NULL;
+    hs_spi_target->spare = NULL;
+    hs_spi_target->xfers = NULL;
+    hs_spi_target->head = 0;
+    hs_spi_target->count = 0;
+}
+
+hs_spi_target_t *hs_spi_target_create(void)
+{
+    hs_spi_target_t *hs_spi_target = (hs_spi_target_t *)malloc(sizeof(hs_spi_target_t));
+    if (hs_spi_target == NULL)
+    {
+        return NULL;
+    }
+
+    memset(hs_spi_target, 0, sizeof(hs_spi_target_t));
+    pthread_mutex_init(&hs_spi_target->mutex, NULL);
+
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&hs_spi_target->cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    return hs_spi_target;
+}
+
+int hs_spi_target_init(hs_spi_target_t *hs_spi_target, hs_spi_t *hs_spi, const hs_spi_target_config_t *config)
+{
+    if (hs_spi_target == NULL)
+    {
+        return -1;
+    }
+
+    if (hs_spi == NULL)
+    {
+        return -2;
+    }
+
+    if (config == NULL)
+    {
+        return -3;
+    }
+
+    // 接收线程在阻塞的传输中持有 hs_spi 的互斥锁，需先停止接收线程再访问 hs_spi
+    hs_spi_target_stop(hs_spi_target);
+
+    pthread_mutex_lock(&hs_spi_target->mutex);
+    hs_spi_target_release(hs_spi_target);
+
+    size_t max_transfer_len = SIZE_MAX;
+    if ((config->transfer_cb == NULL) && (hs_spi_get_max_transfer_len(hs_spi, &max_transfer_len) < 0))
+    {
+        pthread_mutex_unlock(&hs_spi_target->mutex);
+
+        return -2;
+    }
+
+    // 一条消息的总长度受 SPI 单次最大传输长度限制，未指定预挂起帧数时按该限制缩小默认值
+    hs_spi_target_config_t cfg = *config;
+    cfg.transfer_cb = cfg.transfer_cb == NULL ? hs_spi_transfer : cfg.transfer_cb;
+    if ((cfg.armed_count == 0) && (cfg.frame_len > 0))
+    {
+        size_t fit = max_transfer_len / cfg.frame_len;
+        cfg.armed_count = fit < 8 ? fit : 8;
+    }
+    cfg.ring_size = cfg.ring_size == 0 ? cfg.armed_count * 4 : cfg.ring_size;
+    if ((cfg.frame_len == 0) || (cfg.armed_count == 0) || (cfg.armed_count > HS_SPI_MAX_XFER_COUNT) ||
+        (cfg.armed_count > max_transfer_len / cfg.frame_len) || (cfg.ring_size < cfg.armed_count) ||
+        (cfg.ring_size > SIZE_MAX / cfg.frame_len) || (cfg.sched_priority < 0) || (cfg.sched_priority > 99) ||
+        (cfg.abort_signal < 0))
+    {
+        pthread_mutex_unlock(&hs_spi_target->mutex);
+
+        return -4;
+    }
+
+    hs_spi_target->hs_spi = hs_spi;
+    hs_spi_target->config = cfg;
+    memset(&hs_spi_target->stats, 0, sizeof(hs_spi_target->stats));
+
+    hs_spi_target->ring = (uint8_t *)malloc(cfg.ring_size * cfg.frame_len);
+    hs_spi_target->spare = (uint8_t *)malloc(cfg.frame_len);
+    hs_spi_target->xfers = (hs_spi_xfer_t *)calloc(cfg.armed_count, sizeof(hs_spi_xfer_t));
+    if ((hs_spi_target->ring == NULL) || (hs_spi_target->spare == NULL) || (hs_spi_target->xfers == NULL))
+    {
+        hs_spi_target_release(hs_spi_target);
+        pthread_mutex_unlock(&hs_spi_target->mutex);
+
+        return -5;
+    }
+
+    // 每帧一段，帧间释放片选，使从机控制器按主机的片选边界逐帧接收
+    for (size_t i = 0; i < cfg.armed_count; i++)
+    {
+        hs_spi_target->xfers[i].len = cfg.frame_len;
+        hs_spi_target->xfers[i].cs_change = true;
+    }
+
+    pthread_attr_t thread_attr;
+    pthread_attr_init(&thread_attr);
+    if (cfg.sched_priority > 0)
+    {
+        struct sched_param param = {.sched_priority = cfg.sched_priority};
+        pthread_attr_setinheritsched(&thread_attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&thread_attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&thread_attr, &param);
+    }
+
+    hs_spi_target->stopping = false;
+    hs_spi_target->exited = false;
+    int ret = pthread_create(&hs_spi_target->thread, &thread_attr, hs_spi_target_thread, hs_spi_target);
+    pthread_attr_destroy(&thread_attr);
+    if (ret != 0)
+    {
+        hs_spi_target_release(hs_spi_target);
+        pthread_mutex_unlock(&hs_spi_target->mutex);
+
+        return -6;
+    }
+
+    hs_spi_target->running = true;
+    pthread_mutex_unlock(&hs_spi_target->mutex);
+
+    return 0;
+}
+
+int hs_spi_target_destroy(hs_spi_target_t *hs_spi_target)
+{
+    if (hs_spi_target == NULL)
+    {
+        return -1;
+    }
+
+    hs_spi_target_stop(hs_spi_target);
+
+    pthread_mutex_lock(&hs_spi_target->mutex);
+    hs_spi_target_release(hs_spi_target);
+    pthread_mutex_unlock(&hs_spi_target->mutex);
+
+    pthread_cond_destroy(&hs_spi_target->cond);
+    pthread_mutex_destroy(&hs_spi_target->mutex);
+    free(hs_spi_target);
+
+    return 0;
+}
+
+int hs_spi_target_read_frame(hs_spi_target_t *hs_spi_target, uint8_t *frame, const size_t frame_size,
+                             const int timeout_ms)
+{
+    if (hs_spi_target == NULL)
+    {
+        return -1;
+    }
+
+    if (frame == NULL)
+    {
+        return -2;
+    }
+
+    pthread_mutex_lock(&hs_spi_target->mutex);
+    if (!hs_spi_target->running)
+    {
+        pthread_mutex_unlock(&hs_spi_target->mutex);
+
+        return -3;
+    }
+
+    if (frame_size < hs_spi_target->config.frame_len)
+    {
+        pthread_mutex_unlock(&hs_spi_target->mutex);
+
+        return -4;
+    }
+
+    struct timespec abstime;
+    if (timeout_ms > 0)
+    {
+        hs_spi_target_abstime(&abstime, timeout_ms);
+    }
+
+    while (hs_spi_target->count == 0)
+    {
+        if (timeout_ms == 0)
+        {
+            pthread_mutex_unlock(&hs_spi_target->mutex);
+
+            return -5;
+        }
+
+        if (timeout_ms < 0)
+        {
+            pthread_cond_wait(&hs_spi_target->cond, &hs_spi_target->mutex);
+        }
+        else if (pthread_cond_timedwait(&hs_spi_target->cond, &hs_spi_target->mutex, &abstime) != 0)
+        {
+            if (hs_spi_target->count > 0)
+            {
+                break;
+            }
+
+            pthread_mutex_unlock(&hs_spi_target->mutex);
+
+            return -5;
+        }
+    }
+
+    const size_t frame_len = hs_spi_target->config.frame_len;
+    memcpy(frame, &hs_spi_target->ring[hs_spi_target->head * frame_len], frame_len);
+    hs_spi_target->head = (hs_spi_target->head + 1) % hs_spi_target->config.ring_size;
+    hs_spi_target->count--;
+    pthread_mutex_unlock(&hs_spi_target->mutex);
+
+    return 0;
+}
+
+int hs_spi_target_get_frame_count(hs_spi_target_t *hs_spi_target, size_t *frame_count)
+{
+    if (hs_spi_target == NULL)
+    {
+        return -1;
+    }
+
+    if (frame_count == NULL)
+    {
+        return -2;
+    }
+
+    pthread_mutex_lock(&hs_spi_target->mutex);
+    *frame_count = hs_spi_target->count;
+    pthread_mutex_unlock(&hs_spi_target->mutex);
+
+    return 0;
+}
+
+int hs_spi_target_get_stats(hs_spi_target_t *hs_spi_target, hs_spi_target_stats_t *stats)
+{
+    if (hs_spi_target == NULL)
+    {
+        return -1;
+    }
+
+    if (stats == NULL)
+    {
+        return -2;
+    }
+
+    pthread_mutex_lock(&hs_spi_target->mutex);
+    *stats = hs_spi_target->stats;
+    pthread_mutex_unlock(&hs_spi_target->mutex);
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file      hs_spi_target.h
+ * @brief     SPI 从机（目标）模式接收模块头文件
+ * @author    huenrong (sgyhy1028@outlook.com)
+ * @date      2026-10-18 20:05:43
+ *
+ * @copyright Copyright (c) 2026 huenrong
+ *
+ */
+
+#ifndef __HS_SPI_TARGET_H
+#define __HS_SPI_TARGET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hs_spi.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 传输回调函数（参数与返回值同 hs_spi_transfer）
+typedef int (*hs_spi_target_transfer_cb)(hs_spi_t *hs_spi, const hs_spi_xfer_t *xfers, const size_t xfer_count);
+
+// 从机接收配置
+typedef struct hs_spi_target_config
+{
+    size_t frame_len;                      // 帧长度（单位：字节），主机每次片选传输的字节数
+    size_t armed_count;                    // 预先挂起的接收帧数，为 0 使用默认值 8（超过 SPI 单次最大传输长度时自动减小）
+    size_t ring_size;                      // 环形缓冲区可缓存的帧数（不能小于 armed_count），为 0 使用 armed_count 的 4 倍
+    int sched_priority;                    // 接收线程实时优先级（1-99，SCHED_FIFO），为 0 使用默认调度策略
+    int abort_signal;                      // 停止时用于中断阻塞中接收的信号，为 0 不发送信号
+    hs_spi_target_transfer_cb transfer_cb; // 传输回调函数，为 NULL 使用 hs_spi_transfer（可替换为测试桩等其他实现）
+} hs_spi_target_config_t;
+
+// 从机接收统计
+typedef struct hs_spi_target_stats
+{
+    uint64_t received_frames; // 已存入环形缓冲区的帧数
+    uint64_t dropped_frames;  // 环形缓冲区已满而丢弃的帧数
+    uint64_t error_count;     // 接收失败次数
+    uint64_t message_count;   // 完成的接收消息数，相邻两条消息之间存在一次重新提交的间隙
+    uint64_t max_rearm_us;    // 消息完成到提交下一条消息的最大用户态耗时（单位：微秒），不含内核调度与驱动开销
+} hs_spi_target_stats_t;
+
+// 从机接收对象
+typedef struct _hs_spi_target hs_spi_target_t;
+
+/**
+ * @brief 创建从机接收对象
+ *
+ * @return 成功: 从机接收对象
+ * @return 失败: NULL
+ */
+hs_spi_target_t *hs_spi_target_create(void);
+
+/**
+ * @brief 初始化从机接收对象并启动接收线程
+ *
+ * @note 1. 控制器需工作在从机模式（设备树中声明 spi-slave），hs_spi 打开的是从机控制器下的 spidev 设备，
+ *          spidev 无法通过 ioctl() 切换主从模式
+ *       2. 接收线程将 armed_count 帧作为一条消息一次性提交，帧间释放片选，内核在帧间无需等待用户态重新提交；
+ *          帧直接接收到环形缓冲区中，整条消息完成后才可读取，主机停止发送时未满一条消息的帧需等待后续帧到达
+ *       3. 相邻两条消息之间存在间隙（ioctl() 返回到接收线程重新提交下一条消息），主机在间隙内发送的帧会丢失且不计入
+ *          dropped_frames，主机需在每 armed_count 帧之后留出大于间隙的帧间隔，或增大 armed_count 与 sched_priority
+ *          减少间隙；可通过统计中的 message_count 与 max_rearm_us 评估间隙次数和时长，需要检测丢帧时由主机在帧中
+ *          携带序号，读取者检查序号是否连续
+ *       4. armed_count * frame_len 不能超过 SPI 单次最大传输长度（参考 hs_spi_set_max_transfer_len，
+ *          同时需调整 spidev 模块参数 bufsiz），armed_count 不能超过 HS_SPI_MAX_XFER_COUNT，否则初始化失败
+ *       5. 环形缓冲区空闲帧数不足时，消息中超出部分接收到临时缓冲区并计入丢弃帧数
+ *       6. 设置 abort_signal 时，调用者需安装不带 SA_RESTART 的信号处理函数，停止时通过该信号中断阻塞中的接收
+ *          （需控制器驱动以可中断方式等待）；未设置时停止操作需等待当前消息接收完成
+ *       7. 该函数支持重复调用，重复调用时会停止接收线程、清空环形缓冲区并重新启动，失败时接收线程保持停止
+ *       8. hs_spi 需已初始化，且在从机接收对象销毁前不能销毁，接收期间不能通过 hs_spi 进行其他传输
+ *       9. 设置 transfer_cb 时 hs_spi 只作为回调参数传入，不检查 SPI 单次最大传输长度，由回调自行限制
+ *
+ * @param[in,out] hs_spi_target: 从机接收对象
+ * @param[in]     hs_spi       : SPI 对象
+ * @param[in]     config       : 从机接收配置
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_target_init(hs_spi_target_t *hs_spi_target, hs_spi_t *hs_spi, const hs_spi_target_config_t *config);
+
+/**
+ * @brief 销毁从机接收对象
+ *
+ * @note 1. 调用该函数前必须确保没有其他线程正在使用该从机接收对象，否则可能导致未定义行为
+ *       2. 销毁后，该从机接收对象将不再可用，环形缓冲区中未读取的帧被丢弃
+ *
+ * @param[in,out] hs_spi_target: 从机接收对象
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_target_destroy(hs_spi_target_t *hs_spi_target);
+
+/**
+ * @brief 读取一帧数据
+ *
+ * @param[in,out] hs_spi_target: 从机接收对象
+ * @param[out]    frame        : 读取到的帧
+ * @param[in]     frame_size   : 帧缓冲区大小（不能小于帧长度）
+ * @param[in]     timeout_ms   : 等待超时时间（单位：毫秒），<0 一直等待，0 不等待
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_target_read_frame(hs_spi_target_t *hs_spi_target, uint8_t *frame, const size_t frame_size,
+                             const int timeout_ms);
+
+/**
+ * @brief 获取环形缓冲区中待读取的帧数
+ *
+ * @param[in,out] hs_spi_target: 从机接收对象
+ * @param[out]    frame_count  : 待读取的帧数
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_target_get_frame_count(hs_spi_target_t *hs_spi_target, size_t *frame_count);
+
+/**
+ * @brief 获取接收统计
+ *
+ * @param[in,out] hs_spi_target: 从机接收对象
+ * @param[out]    stats        : 接收统计
+ *
+ * @return 0 : 成功
+ * @return <0: 失败
+ */
+int hs_spi_target_get_stats(hs_spi_target_t *hs_spi_target, hs_spi_target_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __HS_SPI_TARGET_H
@@ -0,0 +1,422 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+SPI 设备驱动代码生成工具
+
+根据 JSON 格式的寄存器描述文件生成基于 hs_spi_regmap 的设备访问代码（<name>_regs.h / <name>_regs.c）:
+    - 寄存器表与设备描述，非易失寄存器由 hs_spi_regmap 缓存，读取和位修改不访问总线
+    - 每个寄存器的读写函数、每个位域的读取和修改函数
+    - 每个突发访问区间的合并读取函数（一次突发读取区间内所有寄存器）
+    - 带 default 的可写寄存器生成默认值写入函数（批量写入，同一突发访问区间内地址连续的寄存器合并为一帧）
+
+用法:
+    python3 tools/hs_spi_regmap_gen.py adxl345.json -o ./generated
+
+寄存器描述文件示例:
+    {
+        "name": "adxl345",
+        "read_flag": "0x80",
+        "write_flag": "0x00",
+        "burst_flag": "0x40",
+        "little_endian": true,
+        "registers": [
+            {"name": "devid", "addr": "0x00", "access": "ro", "volatile": false},
+            {"name": "bw_rate", "addr": "0x2C", "default": "0x0A",
+             "fields": [{"name": "rate", "bits": "3:0"}, {"name": "low_power", "bits": "4"}]},
+            {"name": "datax", "addr": "0x32", "width": 2, "access": "ro"},
+            {"name": "datay", "addr": "0x34", "width": 2, "access": "ro"},
+            {"name": "dataz", "addr": "0x36", "width": 2, "access": "ro"}
+        ],
+        "bursts": [{"name": "data", "first": "datax", "last": "dataz"}]
+    }
+
+字段说明:
+    width   : 寄存器宽度（1/2/4 字节），默认 1
+    access  : ro / wo / rw，默认 rw
+    addr    : 寄存器地址（0x00-0xFF），不能与 read_flag / write_flag / burst_flag 的任何位重叠
+    volatile: 值是否可能被设备修改（不缓存），只读寄存器默认 true，其余默认 false
+    default : 默认值（不能超过寄存器宽度），生成到 <name>_write_defaults()
+    fields  : 位域，bits 为 "高位:低位" 或单个位号
+    bursts  : 可突发访问的连续寄存器区间，区间内寄存器地址必须连续；
+              区间内带 default 的相邻寄存器在 <name>_write_defaults() 中合并为一帧写入
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+IDENT_RE = re.compile(r"^[a-z_][a-z0-9_]*$")
+C_TYPES = {1: "uint8_t", 2: "uint16_t", 4: "uint32_t"}
+
+
+def fail(message):
+    sys.exit("hs_spi_regmap_gen: error: " + message)
+
+
+def parse_int(value, what):
+    if isinstance(value, int):
+        return value
+    try:
+        return int(str(value), 0)
+    except ValueError:
+        fail("%s: invalid number %r" % (what, value))
+
+
+def check_ident(name, what):
+    if not isinstance(name, str) or not IDENT_RE.match(name):
+        fail("%s: %r is not a lower-case C identifier" % (what, name))
+    return name
+
+
+def parse_bits(bits, width, what):
+    parts = str(bits).split(":")
+    if len(parts) == 1:
+        msb = lsb = parse_int(parts[0], what)
+    elif len(parts) == 2:
+        msb, lsb = parse_int(parts[0], what), parse_int(parts[1], what)
+    else:
+        fail("%s: invalid bits %r" % (what, bits))
+    if lsb > msb or msb >= width * 8:
+        fail("%s: bits %r out of range" % (what, bits))
+    return msb, lsb
+
+
+def load(path):
+    with open(path, "r", encoding="utf-8") as f:
+        spec = json.load(f)
+
+    dev = {
+        "name": check_ident(spec.get("name"), "name"),
+        "read_flag": parse_int(spec.get("read_flag", 0), "read_flag"),
+        "write_flag": parse_int(spec.get("write_flag", 0), "write_flag"),
+        "burst_flag": parse_int(spec.get("burst_flag", 0), "burst_flag"),
+        "little_endian": bool(spec.get("little_endian", False)),
+        "registers": [],
+        "bursts": [],
+    }
+    for flag in ("read_flag", "write_flag", "burst_flag"):
+        if not 0 <= dev[flag] <= 0xFF:
+            fail("%s out of range" % flag)
+    # 帧头为 地址 | 标志，与标志重叠的地址位在总线上无法区分
+    flag_bits = dev["read_flag"] | dev["write_flag"] | dev["burst_flag"]
+
+    names = set()
+    for raw in spec.get("registers", []):
+        name = check_ident(raw.get("name"), "register name")
+        if name in names:
+            fail("register %s: duplicate name" % name)
+        names.add(name)
+
+        access = raw.get("access", "rw")
+        if access not in ("ro", "wo", "rw"):
+            fail("register %s: access must be ro, wo or rw" % name)
+        width = parse_int(raw.get("width", 1), "register %s width" % name)
+        if width not in C_TYPES:
+            fail("register %s: width must be 1, 2 or 4" % name)
+        addr = parse_int(raw.get("addr"), "register %s addr" % name)
+        if not 0 <= addr <= 0xFF:
+            fail("register %s: addr out of range" % name)
+        if addr & flag_bits:
+            fail("register %s: addr 0x%02X overlaps flag bits 0x%02X" % (name, addr, flag_bits))
+
+        reg = {
+            "name": name,
+            "addr": addr,
+            "width": width,
+            "access": access,
+            "volatile": bool(raw.get("volatile", access == "ro")),
+            "default": None,
+            "fields": [],
+            "burst_group": 0,
+        }
+        if "default" in raw:
+            if access == "ro":
+                fail("register %s: read-only register cannot have a default" % name)
+            reg["default"] = parse_int(raw["default"], "register %s default" % name)
+            if not 0 <= reg["default"] <= (1 << (8 * width)) - 1:
+                fail("register %s: default %s does not fit in %d byte(s)" % (name, raw["default"], width))
+
+        field_names = set()
+        for raw_field in raw.get("fields", []):
+            field_name = check_ident(raw_field.get("name"), "register %s field name" % name)
+            if field_name in field_names:
+                fail("register %s: duplicate field %s" % (name, field_name))
+            field_names.add(field_name)
+            msb, lsb = parse_bits(raw_field.get("bits"), width, "register %s field %s" % (name, field_name))
+            reg["fields"].append({"name": field_name, "lsb": lsb, "mask": ((1 << (msb - lsb + 1)) - 1) << lsb})
+
+        dev["registers"].append(reg)
+
+    if not dev["registers"]:
+        fail("no registers")
+
+    dev["registers"].sort(key=lambda r: r["addr"])
+    for prev, reg in zip(dev["registers"], dev["registers"][1:]):
+        if prev["addr"] + prev["width"] > reg["addr"]:
+            fail("registers %s and %s overlap" % (prev["name"], reg["name"]))
+
+    index = {reg["name"]: i for i, reg in enumerate(dev["registers"])}
+    for group, raw in enumerate(spec.get("bursts", []), start=1):
+        name = check_ident(raw.get("name"), "burst name")
+        if raw.get("first") not in index or raw.get("last") not in index:
+            fail("burst %s: unknown first/last register" % name)
+        first, last = index[raw["first"]], index[raw["last"]]
+        if first > last:
+            fail("burst %s: first register is after last register" % name)
+        regs = dev["registers"][first:last + 1]
+        for prev, reg in zip(regs, regs[1:]):
+            if prev["addr"] + prev["width"] != reg["addr"]:
+                fail("burst %s: registers %s and %s are not contiguous" % (name, prev["name"], reg["name"]))
+        for reg in regs:
+            if reg["burst_group"]:
+                fail("burst %s: register %s already in another burst" % (name, reg["name"]))
+            reg["burst_group"] = group
+        dev["bursts"].append({"name": name, "first": first, "count": len(regs),
+                              "readable": all(r["access"] != "wo" for r in regs)})
+
+    return dev
+
+
+def gen_header(dev):
+    name = dev["name"]
+    upper = name.upper()
+    guard = "__%s_REGS_H" % upper
+    out = []
+    w = out.append
+
+    w("/**")
+    w(" * @file      %s_regs.h" % name)
+    w(" * @brief     %s 寄存器访问头文件" % name)
+    w(" *")
+    w(" * @note      该文件由 tools/hs_spi_regmap_gen.py 自动生成，请勿手动修改")
+    w(" *")
+    w(" */")
+    w("")
+    w("#ifndef %s" % guard)
+    w("#define %s" % guard)
+    w("")
+    w("#include <stdint.h>")
+    w("")
+    w('#include "hs_spi_regmap.h"')
+    w("")
+    w("#ifdef __cplusplus")
+    w('extern "C"')
+    w("{")
+    w("#endif")
+    w("")
+    w("// 寄存器序号")
+    w("typedef enum %s_reg" % name)
+    w("{")
+    for i, reg in enumerate(dev["registers"]):
+        w("    E_%s_REG_%s = %d," % (upper, reg["name"].upper(), i))
+    w("    E_%s_REG_COUNT," % upper)
+    w("} %s_reg_e;" % name)
+    w("")
+    w("// 寄存器地址")
+    for reg in dev["registers"]:
+        w("#define %s_%s_ADDR 0x%02X" % (upper, reg["name"].upper(), reg["addr"]))
+
+    if any(reg["fields"] for reg in dev["registers"]):
+        w("")
+        w("// 寄存器位域")
+        for reg in dev["registers"]:
+            for field in reg["fields"]:
+                prefix = "%s_%s_%s" % (upper, reg["name"].upper(), field["name"].upper())
+                w("#define %s_POS %d" % (prefix, field["lsb"]))
+                w("#define %s_MSK 0x%0*X" % (prefix, reg["width"] * 2, field["mask"]))
+
+    w("")
+    w("// 设备描述")
+    w("extern const hs_spi_regmap_desc_t %s_regmap_desc;" % name)
+
+    for burst in dev["bursts"]:
+        if not burst["readable"]:
+            continue
+        w("")
+        w("// 突发访问区间 %s" % burst["name"])
+        w("typedef struct %s_%s" % (name, burst["name"]))
+        w("{")
+        for reg in dev["registers"][burst["first"]:burst["first"] + burst["count"]]:
+            w("    %s %s;" % (C_TYPES[reg["width"]], reg["name"]))
+        w("} %s_%s_t;" % (name, burst["name"]))
+        w("")
+        w("/**")
+        w(" * @brief 突发读取 %s 区间内的所有寄存器" % burst["name"])
+        w(" *")
+        w(" * @param[in,out] hs_spi_regmap: 寄存器映射对象")
+        w(" * @param[out]    %s%s: 读取到的寄存器值" % (burst["name"], " " * max(0, 13 - len(burst["name"]))))
+        w(" *")
+        w(" * @return 0 : 成功")
+        w(" * @return <0: 失败")
+        w(" */")
+        w("int %s_read_%s(hs_spi_regmap_t *hs_spi_regmap, %s_%s_t *%s);" %
+          (name, burst["name"], name, burst["name"], burst["name"]))
+
+    if any(reg["default"] is not None for reg in dev["registers"]):
+        w("")
+        w("/**")
+        w(" * @brief 批量写入所有寄存器默认值")
+        w(" *")
+        w(" * @note 与缓存值相同的寄存器被跳过，同一突发访问区间内地址连续的寄存器合并为一帧，所有帧合并为尽量少的消息发送")
+        w(" *")
+        w(" * @param[in,out] hs_spi_regmap: 寄存器映射对象")
+        w(" *")
+        w(" * @return 0 : 成功")
+        w(" * @return <0: 失败")
+        w(" */")
+        w("int %s_write_defaults(hs_spi_regmap_t *hs_spi_regmap);" % name)
+
+    for reg in dev["registers"]:
+        reg_enum = "E_%s_REG_%s" % (upper, reg["name"].upper())
+        w("")
+        w("// 寄存器 %s" % reg["name"])
+        if reg["access"] != "wo":
+            w("static inline int %s_read_%s(hs_spi_regmap_t *hs_spi_regmap, uint32_t *value)" % (name, reg["name"]))
+            w("{")
+            w("    return hs_spi_regmap_read(hs_spi_regmap, %s, value);" % reg_enum)
+            w("}")
+        if reg["access"] != "ro":
+            if reg["access"] != "wo":
+                w("")
+            w("static inline int %s_write_%s(hs_spi_regmap_t *hs_spi_regmap, const uint32_t value)" %
+              (name, reg["name"]))
+            w("{")
+            w("    return hs_spi_regmap_write(hs_spi_regmap, %s, value);" % reg_enum)
+            w("}")
+        for field in reg["fields"]:
+            prefix = "%s_%s_%s" % (upper, reg["name"].upper(), field["name"].upper())
+            func = "%s_%s" % (reg["name"], field["name"])
+            if reg["access"] != "wo":
+                w("")
+                w("static inline int %s_get_%s(hs_spi_regmap_t *hs_spi_regmap, uint32_t *value)" % (name, func))
+                w("{")
+                w("    uint32_t reg_value = 0;")
+                w("    int ret = hs_spi_regmap_read(hs_spi_regmap, %s, &reg_value);" % reg_enum)
+                w("    if (ret < 0)")
+                w("    {")
+                w("        return ret;")
+                w("    }")
+                w("")
+                w("    *value = (reg_value & %s_MSK) >> %s_POS;" % (prefix, prefix))
+                w("")
+                w("    return 0;")
+                w("}")
+            if reg["access"] == "rw":
+                w("")
+                w("static inline int %s_set_%s(hs_spi_regmap_t *hs_spi_regmap, const uint32_t value)" % (name, func))
+                w("{")
+                w("    return hs_spi_regmap_update_bits(hs_spi_regmap, %s, %s_MSK, value << %s_POS);" %
+                  (reg_enum, prefix, prefix))
+                w("}")
+
+    w("")
+    w("#ifdef __cplusplus")
+    w("}")
+    w("#endif")
+    w("")
+    w("#endif // %s" % guard)
+
+    return "\n".join(out) + "\n"
+
+
+def gen_source(dev):
+    name = dev["name"]
+    upper = name.upper()
+    out = []
+    w = out.append
+
+    w("/**")
+    w(" * @file      %s_regs.c" % name)
+    w(" * @brief     %s 寄存器访问源文件" % name)
+    w(" *")
+    w(" * @note      该文件由 tools/hs_spi_regmap_gen.py 自动生成，请勿手动修改")
+    w(" *")
+    w(" */")
+    w("")
+    w('#include "%s_regs.h"' % name)
+    w("")
+    w("// 寄存器表")
+    w("static const hs_spi_regmap_reg_t %s_regs[E_%s_REG_COUNT] = {" % (name, upper))
+    for reg in dev["registers"]:
+        flags = []
+        if reg["access"] != "wo":
+            flags.append("HS_SPI_REGMAP_FLAG_READ")
+        if reg["access"] != "ro":
+            flags.append("HS_SPI_REGMAP_FLAG_WRITE")
+        if reg["volatile"]:
+            flags.append("HS_SPI_REGMAP_FLAG_VOLATILE")
+        w("    [E_%s_REG_%s] = {0x%02X, %d, %s, %d}," %
+          (upper, reg["name"].upper(), reg["addr"], reg["width"], " | ".join(flags), reg["burst_group"]))
+    w("};")
+    w("")
+    w("const hs_spi_regmap_desc_t %s_regmap_desc = {" % name)
+    w("    .regs = %s_regs," % name)
+    w("    .reg_count = E_%s_REG_COUNT," % upper)
+    w("    .read_flag = 0x%02X," % dev["read_flag"])
+    w("    .write_flag = 0x%02X," % dev["write_flag"])
+    w("    .burst_flag = 0x%02X," % dev["burst_flag"])
+    w("    .little_endian = %s," % ("true" if dev["little_endian"] else "false"))
+    w("    .max_message_len = 0,")
+    w("};")
+
+    for burst in dev["bursts"]:
+        if not burst["readable"]:
+            continue
+        regs = dev["registers"][burst["first"]:burst["first"] + burst["count"]]
+        first_enum = "E_%s_REG_%s" % (upper, regs[0]["name"].upper())
+        w("")
+        w("int %s_read_%s(hs_spi_regmap_t *hs_spi_regmap, %s_%s_t *%s)" %
+          (name, burst["name"], name, burst["name"], burst["name"]))
+        w("{")
+        w("    if (%s == NULL)" % burst["name"])
+        w("    {")
+        w("        return -1;")
+        w("    }")
+        w("")
+        w("    uint32_t values[%d] = {0};" % len(regs))
+        w("    if (hs_spi_regmap_read_range(hs_spi_regmap, %s, %d, values) < 0)" % (first_enum, len(regs)))
+        w("    {")
+        w("        return -2;")
+        w("    }")
+        w("")
+        for i, reg in enumerate(regs):
+            w("    %s->%s = (%s)values[%d];" % (burst["name"], reg["name"], C_TYPES[reg["width"]], i))
+        w("")
+        w("    return 0;")
+        w("}")
+
+    defaults = [reg for reg in dev["registers"] if reg["default"] is not None]
+    if defaults:
+        w("")
+        w("int %s_write_defaults(hs_spi_regmap_t *hs_spi_regmap)" % name)
+        w("{")
+        w("    static const hs_spi_regmap_write_t defaults[] = {")
+        for reg in defaults:
+            w("        {E_%s_REG_%s, 0x%0*X}," % (upper, reg["name"].upper(), reg["width"] * 2, reg["default"]))
+        w("    };")
+        w("")
+        w("    return hs_spi_regmap_write_list(hs_spi_regmap, defaults, sizeof(defaults) / sizeof(defaults[0]));")
+        w("}")
+
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate hs_spi_regmap based C driver code from a register description.")
+    parser.add_argument("description", help="register description file (JSON)")
+    parser.add_argument("-o", "--output-dir", default=".", help="output directory (default: current directory)")
+    args = parser.parse_args()
+
+    dev = load(args.description)
+    os.makedirs(args.output_dir, exist_ok=True)
+    for suffix, content in (("_regs.h", gen_header(dev)), ("_regs.c", gen_source(dev))):
+        path = os.path.join(args.output_dir, dev["name"] + suffix)
+        with open(path, "w", encoding="utf-8") as f:
+            f.write(content)
+        print(path)
+
+
+if __name__ == "__main__":
+    main()